@@ -0,0 +1,222 @@
+/*
+ * AnimatedImage.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <Mini2D/AnimatedImage.hpp>              // Class definition
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// SpriteSheet Functions
+	//---------------------------------------------------------------------------
+	SpriteSheet::SpriteSheet(Image * image) : _image(image) {
+
+	}
+
+	SpriteSheet::~SpriteSheet() {
+		unsigned int i;
+
+		// Detach remaining instances so they don't reference a freed sheet
+		for (i = 0; i < _instances.size(); i++) {
+			_instances[i]->_sheet = NULL;
+			_instances[i]->_index = -1;
+		}
+
+		_instances.clear();
+		_frames.clear();
+		_image = NULL;
+	}
+
+	int SpriteSheet::AddFrame(float x, float y, float w, float h, float duration) {
+		SpriteFrame frame;
+
+		frame.X = x;
+		frame.Y = y;
+		frame.W = w;
+		frame.H = h;
+		frame.Duration = duration;
+		_frames.push_back(frame);
+
+		return _frames.size() - 1;
+	}
+
+	int SpriteSheet::AddFrames(float x, float y, float frameWidth, float frameHeight, int columns, int count, float duration) {
+		int i, first = _frames.size();
+
+		if (columns <= 0 || count <= 0)
+			return -1;
+
+		for (i = 0; i < count; i++)
+			AddFrame(x + (i % columns) * frameWidth, y + (i / columns) * frameHeight, frameWidth, frameHeight, duration);
+
+		return first;
+	}
+
+	void SpriteSheet::Update(float deltaTime) {
+		unsigned int i;
+
+		if (_frames.empty())
+			return;
+
+		for (i = 0; i < _instances.size(); i++)
+			_instances[i]->advance(&_frames[0], _frames.size(), deltaTime);
+	}
+
+	int SpriteSheet::GetFrameCount() {
+		return _frames.size();
+	}
+
+	const SpriteSheet::SpriteFrame * SpriteSheet::GetFrame(int index) {
+		if (index < 0 || index >= (int)_frames.size())
+			return NULL;
+		return &_frames[index];
+	}
+
+	Image * SpriteSheet::GetImage() {
+		return _image;
+	}
+
+	void SpriteSheet::addInstance(AnimatedImage * instance) {
+		instance->_index = _instances.size();
+		_instances.push_back(instance);
+	}
+
+	void SpriteSheet::removeInstance(AnimatedImage * instance) {
+		int index = instance->_index;
+
+		if (index < 0 || index >= (int)_instances.size())
+			return;
+
+		// Swap with the last instance so removal is O(1)
+		_instances[index] = _instances.back();
+		_instances[index]->_index = index;
+		_instances.pop_back();
+		instance->_index = -1;
+	}
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	AnimatedImage::AnimatedImage(SpriteSheet * sheet) : _sheet(sheet) {
+		ZIndex = 0;
+		Mode = ANIMATION_LOOP;
+		Speed = 1;
+		Playing = 1;
+
+		_first = 0;
+		_last = -1;
+		_frame = 0;
+		_direction = 1;
+		_time = 0;
+		_index = -1;
+
+		if (_sheet)
+			_sheet->addInstance(this);
+	}
+
+	AnimatedImage::~AnimatedImage() {
+		if (_sheet)
+			_sheet->removeInstance(this);
+		_sheet = NULL;
+	}
+
+	//---------------------------------------------------------------------------
+	// Frame Functions
+	//---------------------------------------------------------------------------
+	void AnimatedImage::SetFrames(int first, int last) {
+		_first = first < 0 ? 0 : first;
+		_last = last;
+		_frame = _first;
+		_direction = 1;
+		_time = 0;
+		Playing = 1;
+	}
+
+	void AnimatedImage::SetFrame(int index) {
+		_frame = index;
+		_time = 0;
+	}
+
+	int AnimatedImage::GetFrame() {
+		return _frame;
+	}
+
+	void AnimatedImage::Update(float deltaTime) {
+		if (!_sheet || !_sheet->GetFrameCount())
+			return;
+
+		advance(_sheet->GetFrame(0), _sheet->GetFrameCount(), deltaTime);
+	}
+
+	void AnimatedImage::advance(const SpriteSheet::SpriteFrame * frames, int frameCount, float deltaTime) {
+		int first, last, steps, maxSteps;
+
+		if (!Playing)
+			return;
+
+		last = (_last < 0 || _last >= frameCount) ? frameCount - 1 : _last;
+		first = _first > last ? last : _first;
+		if (_frame < first || _frame > last)
+			_frame = first;
+
+		_time += deltaTime * Speed;
+
+		// A ping pong cycle visits each frame twice. Anything longer (or zero length frames) is not worth stepping through
+		maxSteps = (last - first + 1) * 2;
+		for (steps = 0; _time >= frames[_frame].Duration; steps++) {
+			if (steps >= maxSteps) {
+				_time = 0;
+				break;
+			}
+
+			_time -= frames[_frame].Duration;
+			if (!step(first, last)) {
+				Playing = 0;
+				_time = 0;
+				break;
+			}
+		}
+	}
+
+	bool AnimatedImage::step(int first, int last) {
+		switch (Mode) {
+			case ANIMATION_LOOP:
+				_frame = _frame >= last ? first : _frame + 1;
+				break;
+			case ANIMATION_ONCE:
+				if (_frame >= last)
+					return 0;
+				_frame++;
+				break;
+			case ANIMATION_PING_PONG:
+				if (first == last)
+					break;
+				if ((_frame + _direction) > last || (_frame + _direction) < first)
+					_direction = -_direction;
+				_frame += _direction;
+				break;
+		}
+
+		return 1;
+	}
+
+	//---------------------------------------------------------------------------
+	// Draw Functions
+	//---------------------------------------------------------------------------
+	void AnimatedImage::Draw(unsigned int rgba) {
+		const SpriteSheet::SpriteFrame * frame;
+
+		if (!_sheet || !_sheet->GetImage())
+			return;
+
+		frame = _sheet->GetFrame(_frame);
+		if (!frame)
+			return;
+
+		_sheet->GetImage()->DrawPart(&DrawRegion, ZIndex, frame->X, frame->Y, frame->W, frame->H, rgba);
+	}
+
+}
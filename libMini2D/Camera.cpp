@@ -0,0 +1,77 @@
+/*
+ * Camera.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <Mini2D/Camera.hpp>                     // Class definition
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	Camera::Camera(Mini * mini) : _mini(mini) {
+		Zoom = 1;
+		Rotation = 0;
+
+		if (!mini)
+			return;
+
+		Position.Set(mini->MAXW/2, mini->MAXH/2);
+		Origin.Set(mini->MAXW/2, mini->MAXH/2);
+	}
+
+	Camera::~Camera() {
+		_mini = NULL;
+	}
+
+	//---------------------------------------------------------------------------
+	// Conversion Functions
+	//---------------------------------------------------------------------------
+	Vector2 Camera::WorldToScreen(const Vector2& world) {
+		Vector2 v = world - Position;
+		Vector2 zero;
+
+		// Rotating the camera rotates the world the other way
+		v.RotateAroundPoint(&zero, -Rotation);
+		v *= Zoom;
+
+		return v + Origin;
+	}
+
+	Vector2 Camera::ScreenToWorld(const Vector2& screen) {
+		Vector2 v = screen - Origin;
+		Vector2 zero;
+
+		if (Zoom)
+			v /= Zoom;
+		v.RotateAroundPoint(&zero, Rotation);
+
+		return v + Position;
+	}
+
+	void Camera::GetVisibleBounds(float * minX, float * minY, float * maxX, float * maxY) {
+		int i;
+		Vector2 corners[4];
+
+		if (!_mini || !minX || !minY || !maxX || !maxY)
+			return;
+
+		corners[0] = ScreenToWorld(Vector2(_mini->MINW, _mini->MINH));
+		corners[1] = ScreenToWorld(Vector2(_mini->MAXW, _mini->MINH));
+		corners[2] = ScreenToWorld(Vector2(_mini->MAXW, _mini->MAXH));
+		corners[3] = ScreenToWorld(Vector2(_mini->MINW, _mini->MAXH));
+
+		*minX = *maxX = corners[0].X;
+		*minY = *maxY = corners[0].Y;
+		for (i = 1; i < 4; i++) {
+			if (corners[i].X < *minX) *minX = corners[i].X;
+			if (corners[i].X > *maxX) *maxX = corners[i].X;
+			if (corners[i].Y < *minY) *minY = corners[i].Y;
+			if (corners[i].Y > *maxY) *maxY = corners[i].Y;
+		}
+	}
+
+}
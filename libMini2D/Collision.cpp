@@ -0,0 +1,611 @@
+/*
+ * Collision.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <math.h>                                // floor(), fabs(), sqrt()
+
+#include <Mini2D/Collision.hpp>                  // Class definition
+
+namespace Mini2D {
+
+	// Distance from point p to the segment a-b
+	static float segmentDistance(Vector2 * p, Vector2 * a, Vector2 * b);
+
+	// Project polygon onto axis
+	static void project(Vector2 * polygon[], int polyCount, float ax, float ay, float * min, float * max);
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	Collision::Collision(float cellSize, unsigned int maxBodies) {
+		unsigned int buckets = 16;
+
+		_cellSize = cellSize > 0 ? cellSize : 64;
+		_invCellSize = 1 / _cellSize;
+		_queryCount = 0;
+
+		// Twice as many buckets as bodies keeps the chains short
+		while (buckets < maxBodies*2)
+			buckets <<= 1;
+		_tableMask = buckets - 1;
+
+		_bodies.reserve(maxBodies);
+		_entries.reserve(maxBodies*4);
+		_pairs.reserve(maxBodies);
+		_bucketStart.resize(buckets + 1, 0);
+		_bucketCursor.resize(buckets, 0);
+		_bucketStamp.resize(buckets, -1);
+	}
+
+	Collision::~Collision() {
+		Clear();
+	}
+
+	//---------------------------------------------------------------------------
+	// Body Functions
+	//---------------------------------------------------------------------------
+	int Collision::Add(CircleF * circle) {
+		CollisionBody body = CollisionBody();
+
+		if (!circle)
+			return -1;
+
+		body.type = COLLIDER_CIRCLE;
+		body.circle = circle;
+		return addBody(body);
+	}
+
+	int Collision::Add(RectangleF * rectangle) {
+		CollisionBody body = CollisionBody();
+
+		if (!rectangle)
+			return -1;
+
+		body.type = COLLIDER_RECTANGLE;
+		body.rectangle = rectangle;
+		return addBody(body);
+	}
+
+	int Collision::Add(Vector2 * polygon[], int polyCount) {
+		CollisionBody body = CollisionBody();
+
+		if (!polygon || polyCount < 2)
+			return -1;
+
+		body.type = COLLIDER_POLYGON;
+		body.polygon = polygon;
+		body.polyCount = polyCount;
+		return addBody(body);
+	}
+
+	int Collision::addBody(const CollisionBody& body) {
+		int id;
+
+		if (!_freeIds.empty()) {
+			id = _freeIds.back();
+			_freeIds.pop_back();
+			_bodies[id] = body;
+			return id;
+		}
+
+		_bodies.push_back(body);
+		_queryStamp.push_back(-1);
+		return _bodies.size() - 1;
+	}
+
+	void Collision::Remove(int id) {
+		if (id < 0 || id >= (int)_bodies.size() || _bodies[id].type == COLLIDER_NONE)
+			return;
+
+		_bodies[id].type = COLLIDER_NONE;
+		_freeIds.push_back(id);
+	}
+
+	void Collision::Clear() {
+		unsigned int i;
+
+		_bodies.clear();
+		_freeIds.clear();
+		_entries.clear();
+		_pairs.clear();
+		_queryStamp.clear();
+
+		// Empty every bucket so Query doesn't walk into the cleared entries
+		for (i = 0; i < _bucketStart.size(); i++)
+			_bucketStart[i] = 0;
+	}
+
+	Collision::ColliderType Collision::GetType(int id) {
+		if (id < 0 || id >= (int)_bodies.size())
+			return COLLIDER_NONE;
+
+		return _bodies[id].type;
+	}
+
+	//---------------------------------------------------------------------------
+	// Broadphase Functions
+	//---------------------------------------------------------------------------
+	int Collision::Update() {
+		int i, j, e, end, cx, cy, x0, y0, x1, y1, count;
+		unsigned int b;
+		CollisionBody * a, * o;
+		CollisionPair pair;
+
+		_pairs.clear();
+		count = _bodies.size();
+
+		for (i = 0; i < count; i++)
+			if (_bodies[i].type != COLLIDER_NONE)
+				updateBounds(&_bodies[i]);
+
+		buildHash();
+
+		for (i = 0; i < count; i++) {
+			a = &_bodies[i];
+			if (a->type == COLLIDER_NONE)
+				continue;
+
+			x0 = cell(a->minX); x1 = cell(a->maxX);
+			y0 = cell(a->minY); y1 = cell(a->maxY);
+			for (cy = y0; cy <= y1; cy++) {
+				for (cx = x0; cx <= x1; cx++) {
+					b = hash(cx, cy);
+					end = _bucketStart[b+1];
+					for (e = _bucketStart[b]; e < end; e++) {
+						j = _entries[e];
+						if (j <= i)
+							continue;
+
+						o = &_bodies[j];
+						if (a->maxX < o->minX || a->minX > o->maxX || a->maxY < o->minY || a->minY > o->maxY)
+							continue;
+
+						// Only test the pair in the cell holding the top left of the overlap
+						// so that bodies sharing many cells are tested once
+						if (cell(a->minX > o->minX ? a->minX : o->minX) != cx ||
+							cell(a->minY > o->minY ? a->minY : o->minY) != cy)
+							continue;
+
+						pair.Normal.Set(0,0);
+						if (narrowphase(a, o, &pair.Normal)) {
+							pair.A = i;
+							pair.B = j;
+							_pairs.push_back(pair);
+						}
+					}
+				}
+			}
+		}
+
+		return _pairs.size();
+	}
+
+	const std::vector<Collision::CollisionPair>& Collision::GetPairs() {
+		return _pairs;
+	}
+
+	int Collision::Query(float minX, float minY, float maxX, float maxY, std::vector<int>& results) {
+		int e, end, j, cx, cy, x0, y0, x1, y1, found = 0;
+		CollisionBody * o;
+
+		// Stamp each body with the query number so it is only reported once
+		_queryCount++;
+
+		x0 = cell(minX); x1 = cell(maxX);
+		y0 = cell(minY); y1 = cell(maxY);
+		for (cy = y0; cy <= y1; cy++) {
+			for (cx = x0; cx <= x1; cx++) {
+				unsigned int b = hash(cx, cy);
+				end = _bucketStart[b+1];
+				for (e = _bucketStart[b]; e < end; e++) {
+					j = _entries[e];
+					o = &_bodies[j];
+					if (_queryStamp[j] == _queryCount || o->type == COLLIDER_NONE)
+						continue;
+					if (maxX < o->minX || minX > o->maxX || maxY < o->minY || minY > o->maxY)
+						continue;
+
+					_queryStamp[j] = _queryCount;
+					results.push_back(j);
+					found++;
+				}
+			}
+		}
+
+		return found;
+	}
+
+	void Collision::updateBounds(CollisionBody * body) {
+		int i;
+		Vector2 * c;
+		Vector2 * corners[4];
+
+		switch (body->type) {
+			case COLLIDER_CIRCLE:
+				c = body->circle->GetRotatedCenter();
+				body->minX = c->X - body->circle->Radius;
+				body->maxX = c->X + body->circle->Radius;
+				body->minY = c->Y - body->circle->Radius;
+				body->maxY = c->Y + body->circle->Radius;
+				break;
+			case COLLIDER_RECTANGLE:
+				// Updates corners
+				body->rectangle->GetRotatedCenter();
+				corners[0] = &body->rectangle->TopLeft;
+				corners[1] = &body->rectangle->TopRight;
+				corners[2] = &body->rectangle->BottomRight;
+				corners[3] = &body->rectangle->BottomLeft;
+
+				body->minX = body->maxX = corners[0]->X;
+				body->minY = body->maxY = corners[0]->Y;
+				for (i = 1; i < 4; i++) {
+					if (corners[i]->X < body->minX) body->minX = corners[i]->X;
+					if (corners[i]->X > body->maxX) body->maxX = corners[i]->X;
+					if (corners[i]->Y < body->minY) body->minY = corners[i]->Y;
+					if (corners[i]->Y > body->maxY) body->maxY = corners[i]->Y;
+				}
+				break;
+			case COLLIDER_POLYGON:
+				body->minX = body->maxX = body->polygon[0]->X;
+				body->minY = body->maxY = body->polygon[0]->Y;
+				for (i = 1; i < body->polyCount; i++) {
+					if (body->polygon[i]->X < body->minX) body->minX = body->polygon[i]->X;
+					if (body->polygon[i]->X > body->maxX) body->maxX = body->polygon[i]->X;
+					if (body->polygon[i]->Y < body->minY) body->minY = body->polygon[i]->Y;
+					if (body->polygon[i]->Y > body->maxY) body->maxY = body->polygon[i]->Y;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
+	int Collision::cell(float v) {
+		return (int)floor(v * _invCellSize);
+	}
+
+	unsigned int Collision::hash(int x, int y) {
+		return (((unsigned int)x * 73856093u) ^ ((unsigned int)y * 19349663u)) & _tableMask;
+	}
+
+	void Collision::buildHash() {
+		int i, cx, cy, x0, y0, x1, y1, count, buckets;
+		unsigned int b;
+		CollisionBody * a;
+
+		count = _bodies.size();
+		buckets = _tableMask + 1;
+
+		// Counting sort of bodies into buckets
+		// A body covering several cells that hash to the same bucket is only inserted once (_bucketStamp)
+		for (i = 0; i <= buckets; i++)
+			_bucketStart[i] = 0;
+		for (i = 0; i < buckets; i++)
+			_bucketStamp[i] = -1;
+
+		for (i = 0; i < count; i++) {
+			a = &_bodies[i];
+			if (a->type == COLLIDER_NONE)
+				continue;
+
+			x0 = cell(a->minX); x1 = cell(a->maxX);
+			y0 = cell(a->minY); y1 = cell(a->maxY);
+			for (cy = y0; cy <= y1; cy++) {
+				for (cx = x0; cx <= x1; cx++) {
+					b = hash(cx, cy);
+					if (_bucketStamp[b] != i) {
+						_bucketStamp[b] = i;
+						_bucketStart[b+1]++;
+					}
+				}
+			}
+		}
+
+		for (i = 0; i < buckets; i++) {
+			_bucketStart[i+1] += _bucketStart[i];
+			_bucketCursor[i] = _bucketStart[i];
+			_bucketStamp[i] = -1;
+		}
+
+		_entries.resize(_bucketStart[buckets]);
+
+		for (i = 0; i < count; i++) {
+			a = &_bodies[i];
+			if (a->type == COLLIDER_NONE)
+				continue;
+
+			x0 = cell(a->minX); x1 = cell(a->maxX);
+			y0 = cell(a->minY); y1 = cell(a->maxY);
+			for (cy = y0; cy <= y1; cy++) {
+				for (cx = x0; cx <= x1; cx++) {
+					b = hash(cx, cy);
+					if (_bucketStamp[b] != i) {
+						_bucketStamp[b] = i;
+						_entries[_bucketCursor[b]++] = i;
+					}
+				}
+			}
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Narrowphase Functions
+	//---------------------------------------------------------------------------
+	bool Collision::narrowphase(CollisionBody * a, CollisionBody * b, Vector2 * normal) {
+		Vector2 * ra[4], * rb[4];
+		Vector2 ** pa = a->polygon, ** pb = b->polygon;
+		int ca = a->polyCount, cb = b->polyCount;
+		bool hit = 0;
+
+		// Circle first. The normal is flipped back so that it still points from a to b
+		if (b->type == COLLIDER_CIRCLE && a->type != COLLIDER_CIRCLE) {
+			switch (a->type) {
+				case COLLIDER_RECTANGLE:
+					hit = Intersect(b->circle, a->rectangle, normal);
+					break;
+				case COLLIDER_POLYGON:
+					hit = Intersect(b->circle, a->polygon, a->polyCount, normal, NULL);
+					break;
+				default:
+					return 0;
+			}
+
+			if (hit && normal)
+				normal->Set(-normal->X, -normal->Y);
+			return hit;
+		}
+
+		if (a->type == COLLIDER_CIRCLE) {
+			switch (b->type) {
+				case COLLIDER_CIRCLE:
+					return Intersect(a->circle, b->circle, normal);
+				case COLLIDER_RECTANGLE:
+					return Intersect(a->circle, b->rectangle, normal);
+				case COLLIDER_POLYGON:
+					return Intersect(a->circle, b->polygon, b->polyCount, normal, NULL);
+				default:
+					return 0;
+			}
+		}
+
+		if (a->type == COLLIDER_RECTANGLE && b->type == COLLIDER_RECTANGLE)
+			return Intersect(a->rectangle, b->rectangle, normal);
+
+		// Polygon against rectangle or polygon
+		if (a->type == COLLIDER_RECTANGLE) {
+			ra[0] = &a->rectangle->TopLeft; ra[1] = &a->rectangle->TopRight;
+			ra[2] = &a->rectangle->BottomRight; ra[3] = &a->rectangle->BottomLeft;
+			pa = ra;
+			ca = 4;
+		}
+		if (b->type == COLLIDER_RECTANGLE) {
+			rb[0] = &b->rectangle->TopLeft; rb[1] = &b->rectangle->TopRight;
+			rb[2] = &b->rectangle->BottomRight; rb[3] = &b->rectangle->BottomLeft;
+			pb = rb;
+			cb = 4;
+		}
+
+		return Intersect(pa, ca, pb, cb, normal);
+	}
+
+	bool Collision::Intersect(CircleF * a, CircleF * b, Vector2 * normal) {
+		Vector2 * c0, * c1;
+
+		if (!a || !b)
+			return 0;
+
+		c0 = a->GetRotatedCenter();
+		c1 = b->GetRotatedCenter();
+
+		if (Vector2::DistanceFrom(c0, c1) < (a->Radius + b->Radius)) {
+			if (normal) {
+				normal->Set((*c1 - *c0));
+				if (normal->X || normal->Y)
+					normal->Normalize();
+			}
+
+			return 1;
+		}
+
+		return 0;
+	}
+
+	bool Collision::Intersect(CircleF * circle, RectangleF * rectangle, Vector2 * normal) {
+		Vector2 * rect[4];
+
+		if (!circle || !rectangle)
+			return 0;
+
+		// Update corners
+		rectangle->GetRotatedCenter();
+
+		rect[0] = &rectangle->BottomRight;
+		rect[1] = &rectangle->BottomLeft;
+		rect[2] = &rectangle->TopLeft;
+		rect[3] = &rectangle->TopRight;
+
+		return Intersect(circle, rect, 4, normal, NULL);
+	}
+
+	bool Collision::Intersect(CircleF * circle, Vector2 * polygon[], int polyCount, Vector2 * normal, int * points) {
+		int i, c = 0, side = 0;
+		float ex, ey, px, py, cross, d, closest = -1, cx = 0, cy = 0;
+		bool inside = 1;
+		Vector2 * next;
+		Vector2 * center;
+		Vector2 n, edge;
+
+		if (!circle || !polygon || polyCount < 2)
+			return 0;
+
+		center = circle->GetRotatedCenter();
+
+		for (i = 0; i < polyCount; i++) {
+			cx += polygon[i]->X;
+			cy += polygon[i]->Y;
+		}
+		cx /= polyCount;
+		cy /= polyCount;
+
+		for (i = 0; i < polyCount; i++) {
+			next = polygon[((i==polyCount-1)?0:i+1)];
+
+			// Perpendicular of the edge, pointed into the polygon
+			ex = -(next->Y - polygon[i]->Y);
+			ey = next->X - polygon[i]->X;
+			if ((cx - polygon[i]->X) * ex + (cy - polygon[i]->Y) * ey < 0) {
+				ex = -ex;
+				ey = -ey;
+			}
+
+			// The center is inside a convex polygon if it is on the same side of every edge
+			px = center->X - polygon[i]->X;
+			py = center->Y - polygon[i]->Y;
+			cross = (next->X - polygon[i]->X) * py - (next->Y - polygon[i]->Y) * px;
+			if (cross) {
+				if (side && (cross > 0) != (side > 0))
+					inside = 0;
+				side = cross > 0 ? 1 : -1;
+			}
+
+			d = segmentDistance(center, polygon[i], next);
+			if (closest < 0 || d < closest) {
+				closest = d;
+				edge.Set(ex, ey);
+			}
+
+			if (d <= circle->Radius) {
+				n.X += ex;
+				n.Y += ey;
+				c++;
+			}
+		}
+
+		if (points)
+			*points = c;
+
+		// A circle wholly inside the polygon touches no edge. It leaves through the closest one
+		if (c == 0) {
+			if (!inside || polyCount < 3)
+				return 0;
+			n = edge;
+		}
+
+		// If the normal is invalid, return false
+		if (!n.X && !n.Y)
+			return 0;
+
+		if (normal) {
+			n.Normalize();
+			normal->Set(n);
+		}
+
+		return 1;
+	}
+
+	bool Collision::Intersect(Vector2 * a[], int aCount, Vector2 * b[], int bCount, Vector2 * normal) {
+		int i, p;
+		float ax, ay, m, minA, maxA, minB, maxB, overlap, best = -1, bx = 0, by = 0;
+		float cax = 0, cay = 0, cbx = 0, cby = 0;
+		Vector2 ** poly;
+		int polyCount;
+
+		if (!a || !b || aCount < 2 || bCount < 2)
+			return 0;
+
+		// Test every edge normal of both polygons as a separating axis
+		for (p = 0; p < 2; p++) {
+			poly = p ? b : a;
+			polyCount = p ? bCount : aCount;
+
+			for (i = 0; i < polyCount; i++) {
+				Vector2 * next = poly[((i==polyCount-1)?0:i+1)];
+				ax = -(next->Y - poly[i]->Y);
+				ay = next->X - poly[i]->X;
+				m = sqrt(ax*ax + ay*ay);
+				if (m == 0)
+					continue;
+				ax /= m;
+				ay /= m;
+
+				project(a, aCount, ax, ay, &minA, &maxA);
+				project(b, bCount, ax, ay, &minB, &maxB);
+
+				overlap = (maxA < maxB ? maxA : maxB) - (minA > minB ? minA : minB);
+				if (overlap <= 0)
+					return 0;
+
+				if (best < 0 || overlap < best) {
+					best = overlap;
+					bx = ax;
+					by = ay;
+				}
+			}
+		}
+
+		if (normal) {
+			// Point the axis from a to b
+			for (i = 0; i < aCount; i++) { cax += a[i]->X; cay += a[i]->Y; }
+			for (i = 0; i < bCount; i++) { cbx += b[i]->X; cby += b[i]->Y; }
+			if ((cbx/bCount - cax/aCount) * bx + (cby/bCount - cay/aCount) * by < 0) {
+				bx = -bx;
+				by = -by;
+			}
+
+			normal->Set(bx, by);
+		}
+
+		return 1;
+	}
+
+	bool Collision::Intersect(RectangleF * a, RectangleF * b, Vector2 * normal) {
+		Vector2 * ra[4], * rb[4];
+
+		if (!a || !b)
+			return 0;
+
+		// Update corners
+		a->GetRotatedCenter();
+		b->GetRotatedCenter();
+
+		ra[0] = &a->TopLeft; ra[1] = &a->TopRight; ra[2] = &a->BottomRight; ra[3] = &a->BottomLeft;
+		rb[0] = &b->TopLeft; rb[1] = &b->TopRight; rb[2] = &b->BottomRight; rb[3] = &b->BottomLeft;
+
+		return Intersect(ra, 4, rb, 4, normal);
+	}
+
+	//---------------------------------------------------------------------------
+	// Private Functions
+	//---------------------------------------------------------------------------
+	static float segmentDistance(Vector2 * p, Vector2 * a, Vector2 * b) {
+		float dx = b->X - a->X, dy = b->Y - a->Y;
+		float px = p->X - a->X, py = p->Y - a->Y;
+		float l = dx*dx + dy*dy, t = 0;
+
+		if (l > 0) {
+			t = (px*dx + py*dy) / l;
+			if (t < 0) t = 0;
+			else if (t > 1) t = 1;
+		}
+
+		px -= t*dx;
+		py -= t*dy;
+		return sqrt(px*px + py*py);
+	}
+
+	static void project(Vector2 * polygon[], int polyCount, float ax, float ay, float * min, float * max) {
+		int i;
+		float d;
+
+		*min = *max = polygon[0]->X*ax + polygon[0]->Y*ay;
+		for (i = 1; i < polyCount; i++) {
+			d = polygon[i]->X*ax + polygon[i]->Y*ay;
+			if (d < *min) *min = d;
+			if (d > *max) *max = d;
+		}
+	}
+
+}
@@ -0,0 +1,258 @@
+/*
+ * Decoder.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifdef MINI2D_PORTABLE_DECODER
+
+#include <stdio.h>                               // FILE (jpeglib.h)
+#include <string.h>                              // memcpy
+#include <setjmp.h>                              // setjmp, longjmp
+#include <malloc.h>                              // memalign, malloc
+
+#include <png.h>                                 // libpng
+#include <jpeglib.h>                             // libjpeg
+
+#include <Mini2D/Pixel.hpp>                      // Row conversion
+#include <Mini2D/Decoder.hpp>                    // Class definition
+
+#define ROW(argb, pitch, y) ((unsigned int *)((unsigned char *)(argb) + (y) * (pitch)))
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// Decode Functions
+	//---------------------------------------------------------------------------
+	bool Decoder::GetSize(const void * buffer, unsigned int size, DecoderType type, int * width, int * height) {
+		int w = 0, h = 0;
+		bool result = 0;
+
+		if (!buffer || !size)
+			return 0;
+
+		switch (type) {
+			case DECODER_TYPE_PNG:
+				result = decodePNG(buffer, size, &w, &h, NULL, 0, 0);
+				break;
+			case DECODER_TYPE_JPG:
+				result = decodeJPG(buffer, size, &w, &h, NULL, 0);
+				break;
+		}
+
+		if (width)
+			*width = w;
+		if (height)
+			*height = h;
+		return result && w > 0 && h > 0;
+	}
+
+	bool Decoder::Decode(const void * buffer, unsigned int size, DecoderType type, unsigned int * argb, int pitch, bool premultiply) {
+		int w = 0, h = 0;
+		bool result = 0;
+
+		if (!buffer || !size || !argb)
+			return 0;
+
+		switch (type) {
+			case DECODER_TYPE_PNG:
+				result = decodePNG(buffer, size, &w, &h, argb, pitch, premultiply);
+				break;
+			case DECODER_TYPE_JPG:
+				result = decodeJPG(buffer, size, &w, &h, argb, pitch);
+				break;
+		}
+
+		return result;
+	}
+
+	//---------------------------------------------------------------------------
+	// PNG Functions
+	//---------------------------------------------------------------------------
+	typedef struct _pngSource_t {
+		const unsigned char * data;
+		unsigned int size;
+		unsigned int offset;
+	} PngSource;
+
+	static void pngRead(png_structp png, png_bytep out, png_size_t count) {
+		PngSource * source = (PngSource *)png_get_io_ptr(png);
+
+		if (count > source->size - source->offset)
+			png_error(png, "read past end of buffer");
+
+		memcpy(out, source->data + source->offset, count);
+		source->offset += count;
+	}
+
+	// Fail without printing (corrupt buffers are expected when fuzzing)
+	static void pngError(png_structp png, png_const_charp message) {
+		png_longjmp(png, 1);
+	}
+
+	static void pngWarning(png_structp png, png_const_charp message) {
+	}
+
+	void Decoder::writeRow(unsigned char * rgba, unsigned int * argb, int width, bool premultiply) {
+		if (!premultiply) {
+			Pixel::FromRGBA(rgba, argb, width);
+			return;
+		}
+
+		// Convert and premultiply in the system memory row, then write it out once
+		Pixel::FromRGBA(rgba, (unsigned int *)rgba, width);
+		Pixel::Premultiply((unsigned int *)rgba, width, 1, width * 4);
+		memcpy(argb, rgba, width * 4);
+	}
+
+	bool Decoder::decodePNG(const void * buffer, unsigned int size, int * width, int * height, unsigned int * argb, int pitch, bool premultiply) {
+		png_structp png;
+		png_infop info;
+		PngSource source;
+		png_bytep * volatile rows = NULL;           // Freed after a longjmp (no destructors run past setjmp)
+		unsigned char * volatile scratch = NULL;    // Freed after a longjmp
+		int y, passes;
+
+		if (size < 8 || png_sig_cmp((png_bytep)buffer, 0, 8))
+			return 0;
+
+		png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, pngError, pngWarning);
+		if (!png)
+			return 0;
+		info = png_create_info_struct(png);
+		if (!info) {
+			png_destroy_read_struct(&png, NULL, NULL);
+			return 0;
+		}
+
+		if (setjmp(png_jmpbuf(png))) {
+			png_destroy_read_struct(&png, &info, NULL);
+			if (rows)
+				free(rows);
+			if (scratch)
+				free(scratch);
+			return 0;
+		}
+
+		source.data = (const unsigned char *)buffer;
+		source.size = size;
+		source.offset = 0;
+		png_set_read_fn(png, &source, pngRead);
+		png_read_info(png, info);
+
+		*width = png_get_image_width(png, info);
+		*height = png_get_image_height(png, info);
+		if (!argb || pitch < *width * 4) {
+			png_destroy_read_struct(&png, &info, NULL);
+			return !argb;
+		}
+
+		// Every color type becomes 8 bit RGBA
+		png_set_expand(png);
+		png_set_strip_16(png);
+		png_set_gray_to_rgb(png);
+		png_set_filler(png, 0xFF, PNG_FILLER_AFTER);
+		passes = png_set_interlace_handling(png);
+		png_read_update_info(png, info);
+
+		// The destination is only written to, never read, since it may be video memory.
+		// Interlaced images revisit rows so they need the whole image, anything else needs one row
+		scratch = (unsigned char *)memalign(16, *width * 4 * (passes > 1 ? *height : 1));
+		if (!scratch)
+			png_longjmp(png, 1);
+
+		if (passes > 1) {
+			rows = (png_bytep *)malloc(*height * sizeof(png_bytep));
+			if (!rows)
+				png_longjmp(png, 1);
+			for (y = 0; y < *height; y++)
+				rows[y] = scratch + y * *width * 4;
+			png_read_image(png, rows);
+			for (y = 0; y < *height; y++)
+				writeRow(rows[y], ROW(argb, pitch, y), *width, premultiply);
+		}
+		else {
+			for (y = 0; y < *height; y++) {
+				png_read_row(png, scratch, NULL);
+				writeRow(scratch, ROW(argb, pitch, y), *width, premultiply);
+			}
+		}
+
+		png_read_end(png, NULL);
+		png_destroy_read_struct(&png, &info, NULL);
+		if (rows)
+			free(rows);
+		free(scratch);
+
+		return 1;
+	}
+
+	//---------------------------------------------------------------------------
+	// JPG Functions
+	//---------------------------------------------------------------------------
+	typedef struct _jpgError_t {
+		struct jpeg_error_mgr mgr;
+		jmp_buf jump;
+	} JpgError;
+
+	static void jpgErrorExit(j_common_ptr info) {
+		longjmp(((JpgError *)info->err)->jump, 1);
+	}
+
+	static void jpgOutputMessage(j_common_ptr info) {
+	}
+
+	bool Decoder::decodeJPG(const void * buffer, unsigned int size, int * width, int * height, unsigned int * argb, int pitch) {
+		struct jpeg_decompress_struct jpg;
+		JpgError error;
+		unsigned char * volatile row = NULL;    // Freed after a longjmp
+
+		jpg.err = jpeg_std_error(&error.mgr);
+		error.mgr.error_exit = jpgErrorExit;
+		error.mgr.output_message = jpgOutputMessage;
+		if (setjmp(error.jump)) {
+			jpeg_destroy_decompress(&jpg);
+			if (row)
+				free(row);
+			return 0;
+		}
+
+		jpeg_create_decompress(&jpg);
+		jpeg_mem_src(&jpg, (unsigned char *)buffer, size);
+		if (jpeg_read_header(&jpg, TRUE) != JPEG_HEADER_OK) {
+			jpeg_destroy_decompress(&jpg);
+			return 0;
+		}
+
+		*width = jpg.image_width;
+		*height = jpg.image_height;
+		if (!argb || pitch < *width * 4) {
+			jpeg_destroy_decompress(&jpg);
+			return !argb;
+		}
+
+		// One row of RGB is expanded into the destination at a time
+		jpg.out_color_space = JCS_RGB;
+		jpeg_start_decompress(&jpg);
+		row = (unsigned char *)memalign(16, (jpg.output_width * 3 + 15) & ~15);
+		if (!row)
+			longjmp(error.jump, 1);
+
+		while (jpg.output_scanline < jpg.output_height) {
+			unsigned int * dst = ROW(argb, pitch, jpg.output_scanline);
+			JSAMPROW line = row;
+			jpeg_read_scanlines(&jpg, &line, 1);
+			Pixel::FromRGB(row, dst, jpg.output_width);
+		}
+
+		jpeg_finish_decompress(&jpg);
+		jpeg_destroy_decompress(&jpg);
+		free(row);
+
+		return 1;
+	}
+
+}
+
+#endif /* MINI2D_PORTABLE_DECODER */
@@ -0,0 +1,187 @@
+/*
+ * DrawQueue.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <string.h>                              // memcpy, memset
+
+#include <Mini2D/DrawQueue.hpp>                  // Class definition
+
+#define RADIX_BITS       8
+#define RADIX_BUCKETS    (1 << RADIX_BITS)
+#define RADIX_PASSES     (64 / RADIX_BITS)
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	DrawQueue::DrawQueue(unsigned int reserve) {
+		_commands.reserve(reserve);
+		_quads.reserve(reserve);
+		_keys.reserve(reserve);
+		_keysTmp.reserve(reserve);
+		_order.reserve(reserve);
+		_orderTmp.reserve(reserve);
+		_sorted = 0;
+	}
+
+	DrawQueue::~DrawQueue() {
+		_commands.clear();
+		_quads.clear();
+		_views.clear();
+	}
+
+	//---------------------------------------------------------------------------
+	// Record Functions
+	//---------------------------------------------------------------------------
+	void DrawQueue::Clear() {
+		// clear() keeps capacity so a steady state frame does not allocate
+		_commands.clear();
+		_quads.clear();
+		_views.clear();
+		_sorted = 0;
+	}
+
+	void DrawQueue::Push(const DrawCommand& command) {
+		_commands.push_back(command);
+		_commands.back().First = _quads.size();
+		_commands.back().Count = 0;
+		_sorted = 0;
+	}
+
+	void DrawQueue::AddQuad(const float * x, const float * y, const float * u, const float * v, unsigned int rgba) {
+		static const float quadU[4] = { 0.0f, 0.999999f, 0.999999f, 0.0f };
+		static const float quadV[4] = { 0.0f, 0.0f, 0.999999f, 0.999999f };
+		DrawQuad quad;
+
+		if (_commands.empty() || !x || !y)
+			return;
+
+		memcpy(quad.X, x, sizeof(quad.X));
+		memcpy(quad.Y, y, sizeof(quad.Y));
+		memcpy(quad.U, u && v ? u : quadU, sizeof(quad.U));
+		memcpy(quad.V, u && v ? v : quadV, sizeof(quad.V));
+		quad.RGBA[0] = quad.RGBA[1] = quad.RGBA[2] = quad.RGBA[3] = rgba;
+
+		_quads.push_back(quad);
+		_commands.back().Count++;
+	}
+
+	void DrawQueue::AddQuad(const float * x, const float * y, const unsigned int * rgba) {
+		DrawQuad quad;
+
+		if (_commands.empty() || !x || !y || !rgba)
+			return;
+
+		memcpy(quad.X, x, sizeof(quad.X));
+		memcpy(quad.Y, y, sizeof(quad.Y));
+		memset(quad.U, 0, sizeof(quad.U));
+		memset(quad.V, 0, sizeof(quad.V));
+		memcpy(quad.RGBA, rgba, sizeof(quad.RGBA));
+
+		_quads.push_back(quad);
+		_commands.back().Count++;
+	}
+
+	int DrawQueue::AddView(const MATRIX& view) {
+		_views.push_back(view);
+		return _views.size() - 1;
+	}
+
+	//---------------------------------------------------------------------------
+	// Sort Functions
+	//---------------------------------------------------------------------------
+	unsigned long long DrawQueue::key(const DrawCommand& command) {
+		unsigned int z, state;
+
+		// Map the float to an unsigned int that orders the same way, then invert it so higher layers come first
+		memcpy(&z, &command.Z, sizeof(z));
+		z = (z & 0x80000000) ? ~z : (z | 0x80000000);
+		z = ~z;
+
+		// Textures are 16 byte aligned so the low bits are free for the blend state
+		state = ((command.Blend & 0xF) << 28) | ((command.TextureOff >> 4) & 0x0FFFFFFF);
+
+		return ((unsigned long long)z << 32) | state;
+	}
+
+	void DrawQueue::Sort() {
+		unsigned int histogram[RADIX_PASSES][RADIX_BUCKETS];
+		unsigned int i, pass, n = _commands.size(), sum, count, digit;
+
+		if (n == 0) {
+			_order.clear();
+			_sorted = 1;
+			return;
+		}
+
+		// resize() only allocates when the queue grows past its largest size so far
+		_keys.resize(n);
+		_keysTmp.resize(n);
+		_order.resize(n);
+		_orderTmp.resize(n);
+
+		// Build keys and every pass's histogram in one read
+		memset(histogram, 0, sizeof(histogram));
+		for (i = 0; i < n; i++) {
+			_keys[i] = key(_commands[i]);
+			_order[i] = i;
+			for (pass = 0; pass < RADIX_PASSES; pass++)
+				histogram[pass][(_keys[i] >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+		}
+
+		// Least significant digit first. Each pass is a stable counting sort
+		for (pass = 0; pass < RADIX_PASSES; pass++) {
+			unsigned int * h = histogram[pass];
+
+			// Skip digits that are the same for every key (common for blend and high texture bits)
+			if (h[(_keys[0] >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)] == n)
+				continue;
+
+			for (sum = 0, digit = 0; digit < RADIX_BUCKETS; digit++) {
+				count = h[digit];
+				h[digit] = sum;
+				sum += count;
+			}
+
+			for (i = 0; i < n; i++) {
+				digit = (_keys[i] >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+				_keysTmp[h[digit]] = _keys[i];
+				_orderTmp[h[digit]] = _order[i];
+				h[digit]++;
+			}
+
+			_keys.swap(_keysTmp);
+			_order.swap(_orderTmp);
+		}
+
+		_sorted = 1;
+	}
+
+	//---------------------------------------------------------------------------
+	// Get Functions
+	//---------------------------------------------------------------------------
+	unsigned int DrawQueue::Count() {
+		return _commands.size();
+	}
+
+	const DrawQueue::DrawCommand& DrawQueue::Get(unsigned int index) {
+		return _commands[_sorted ? _order[index] : index];
+	}
+
+	const DrawQueue::DrawQuad * DrawQueue::GetQuads(const DrawCommand& command) {
+		if (command.Count == 0)
+			return NULL;
+		return &_quads[command.First];
+	}
+
+	const MATRIX * DrawQueue::GetView(int index) {
+		if (index < 0 || index >= (int)_views.size())
+			return NULL;
+		return &_views[index];
+	}
+
+}
@@ -7,6 +7,13 @@
 
 #include <time.h>                                // time()
 #include <math.h>                                // Trig
+#include <string.h>                              // memmove
+#include <malloc.h>                              // memalign
+#ifdef __ALTIVEC__
+#include <altivec.h>                             // AltiVec intrinsics
+#endif
+
+#include <algorithm>                             // std::nth_element
 
 #include <Mini2D/Emitter.hpp>                    // Class definition
 #include <Mini2D/Units.hpp>                      // vector2
@@ -27,13 +34,24 @@ namespace Mini2D {
 
 		// Set defaults
 		ZIndex = 0;
+		Blend = Mini::BLEND_NORMAL;
 		MinParticles = maxParticles;
 		Revive = 0;
 		SkipExplosion = 0;
+		Ballistic = 0;
+		_ballistic = 0;
 		_loop = 0;
 		_pause = 0;
 		_timeLeft = 0;
 		_activeP = 0;
+		_live = 0;
+		_running = 0;
+		EmissionRate = 0;
+		_emitAccumulator = 0;
+		_rateScale = 1;
+		_freeHead = 0;
+		_freeCount = 0;
+		_time = 0;
 
 		// Full range dispersion
 		RangeVelocityTheta.Set(0,360);
@@ -54,45 +72,102 @@ namespace Mini2D {
 		RangeColorBlue.Set(0,255);
 		RangeColorAlpha.Set(255,255);
 
+		// No affectors
+		Gravity.Set(0, 0);
+		Drag = 0;
+		Restitution = 0.5f;
+		_useColorCurve = 0;
+		_useAlphaCurve = 0;
+		_useSizeCurve = 0;
+
 		// Set draw region to entire screen
 		Clip.Dimension.Set(mini->MAXW, mini->MAXH);
 		Clip.Location.Set(Clip.Dimension.X/2,Clip.Dimension.Y/2);
 
 		ParticleImage = NULL;
+		_pending.Pending = 0;
+		_updated = 0;
+		_deltaTime = 0;
+		_visible = 0;
+
+		// Arrays are padded to a multiple of 4 and 16 byte aligned for vector loads and DMA
+		_capacity = maxParticles <= EMITTER_MAX_PARTICLES ? (maxParticles + 3) & ~3 : 0;
+		_x = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_y = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_vx = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_vy = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_angle = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_spin = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_ttl = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_life = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_w = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_h = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_rgba = (unsigned int*)memalign(16, (size_t)_capacity * sizeof(unsigned int));
+		_birth = (float*)memalign(16, (size_t)_capacity * sizeof(float));
+		_cornersX = (float*)memalign(16, (size_t)_capacity * 4 * sizeof(float));
+		_cornersY = (float*)memalign(16, (size_t)_capacity * 4 * sizeof(float));
+		_colors = (unsigned int*)memalign(16, (size_t)_capacity * sizeof(unsigned int));
+		_dead = (int*)memalign(16, (size_t)_capacity * sizeof(int));
+		_free = (int*)memalign(16, (size_t)_capacity * sizeof(int));
 
-		//_particles = new EmitterParticle[maxParticles]();
-		if (maxParticles)
-			_particles.reserve(maxParticles);
+		if (!_capacity || !_x || !_y || !_vx || !_vy || !_angle || !_spin || !_ttl || !_life || !_w || !_h || !_rgba || !_birth || !_cornersX || !_cornersY || !_colors || !_dead || !_free)
+			_maxP = 0;
+
+		// Room for every particle so cull never allocates
+		_scores.reserve(_maxP);
 	}
 	Emitter::~Emitter() {
+		join();
 		_timeLeft = 0;
 		_activeP = 0;
 		ParticleImage = NULL;
 
-		_particles.clear();
-		//if (_particles)
-		//	delete[] _particles;
-		//_particles = NULL;
+		free(_x);
+		free(_y);
+		free(_vx);
+		free(_vy);
+		free(_angle);
+		free(_spin);
+		free(_ttl);
+		free(_life);
+		free(_w);
+		free(_h);
+		free(_rgba);
+		free(_birth);
+		free(_cornersX);
+		free(_cornersY);
+		free(_colors);
+		free(_dead);
+		free(_free);
+		_jobs.clear();
 	}
 
 	//---------------------------------------------------------------------------
 	// Draw/Particle Setup Functions
 	//---------------------------------------------------------------------------
 	bool Emitter::Start(Vector2 location, float timeToLive) {
-		int i;
+		int i, k;
 		float dt = 1/10.f;
 
 		if (!_maxP || RangeTTL.Y <= 0 || RangeDimensionW.Y <= 0 || RangeDimensionH.Y <= 0 || RangeColorAlpha.Y <= 0)
 			return 0;
 
+		join();
 		_startLocation.Set(location.X, location.Y);
 
+		_updated = 0;
+		_visible = 0;
 		_pause = 0;
 		_loop = 0;
+		_ballistic = Ballistic;
 
 		_activeP = 0;
-		while (!_activeP)
-			_activeP = (int)randomRange(MinParticles, _maxP);
+		_live = 0;
+		_running = 1;
+		_emitAccumulator = 0;
+		_freeHead = 0;
+		_freeCount = 0;
+		_time = 0;
 
 		_timeLeft = timeToLive;
 		if (_timeLeft <= 0) {
@@ -101,129 +176,735 @@ namespace Mini2D {
 			_timeLeft = RangeTTL.Y;
 		}
 
-		_particles.clear();
 		srand(time(NULL));
-		for (i = 0; i < _activeP; i++) {
-			createParticle(location);
-			std::vector<EmitterParticle>::iterator particle = _particles.end()-1;
-
-			// Here we process the next loop of it's life in order to skip the initial explosion
-			if (SkipExplosion) {
-				for (float t=0; t <= RangeTTL.Y*2; t+=dt) {
-					if (particle->TTL > 0) {
-						particle->rect.Location += (_particles[i].velocity * dt);
-						particle->rect.RectangleAngle += _particles[i].angleVelocity * dt;
-						particle->TTL-=dt;
-					}
-					else {
-						_particles.erase(particle);
-						createParticle(location);
-						particle = _particles.end()-1;
-					}
-				}
+
+		// Without a rate every particle spawns now
+		if (EmissionRate <= 0) {
+			while (!_activeP)
+				_activeP = (int)randomRange(MinParticles, _maxP);
+			for (i = 0; i < _activeP; i++)
+				createParticle(i, location);
+			_live = _activeP;
+		}
+
+		// Here we process the next loop of their lives in order to skip the initial explosion (or the wait to fill up)
+		if (SkipExplosion) {
+			for (float t=0; t <= RangeTTL.Y*2; t+=dt) {
+				buildJobs(dt);
+				for (k = 0; k < (int)_jobs.size(); k++)
+					UpdateJob(&_jobs[k]);
+				emit(dt, 1);
 			}
 		}
 
 		return 1;
 	}
 
+	void Emitter::Update(float deltaTime) {
+		int k;
+		JobSystem * jobs = _mini->GetJobSystem();
+
+		join();
+
+		// Updating twice without a Draw must still free the particles that died
+		if (_updated)
+			emit(0, Revive && _timeLeft > 0);
+		buildJobs(_pause ? 0 : deltaTime);
+
+		for (k = 0; k < (int)_jobs.size(); k++) {
+			if (jobs)
+				jobs->Fork(&_pending, UpdateJobs, &_jobs[0], k, k + 1);
+			else
+				UpdateJob(&_jobs[k]);
+		}
+
+		_deltaTime = deltaTime;
+		_updated = 1;
+	}
+
+	void Emitter::buildJobs(float deltaTime) {
+		int i, k, chunks;
+		ParticleJob * job;
+
+		// Particles are drawn if they overlap the bounds of the (possibly rotated) clip region
+		Clip.GetRotatedCenter();
+		float clipMinX = fmin(fmin(Clip.TopLeft.X, Clip.TopRight.X), fmin(Clip.BottomLeft.X, Clip.BottomRight.X));
+		float clipMaxX = fmax(fmax(Clip.TopLeft.X, Clip.TopRight.X), fmax(Clip.BottomLeft.X, Clip.BottomRight.X));
+		float clipMinY = fmin(fmin(Clip.TopLeft.Y, Clip.TopRight.Y), fmin(Clip.BottomLeft.Y, Clip.BottomRight.Y));
+		float clipMaxY = fmax(fmax(Clip.TopLeft.Y, Clip.TopRight.Y), fmax(Clip.BottomLeft.Y, Clip.BottomRight.Y));
+		float dragFactor = Drag > 0 ? expf(-Drag * deltaTime) : 1;
+		ParticleCollider collider;
+		Vector2 * center;
+
+		// Keep the clock small so birth times keep their precision
+		if (_time >= EMITTER_CLOCK_WRAP) {
+			for (i = 0; i < _activeP; i++)
+				_birth[i] -= _time;
+			_time = 0;
+		}
+		_time += deltaTime;
+
+		// Flatten the colliders as they are now
+		_colliders.clear();
+		for (k = 0; k < (int)_rectangleColliders.size(); k++) {
+			RectangleF * rectangle = _rectangleColliders[k];
+			if (rectangle->W() == 0 || rectangle->H() == 0)
+				continue;
+
+			center = rectangle->GetRotatedCenter();
+			collider.MinX = fmin(fmin(rectangle->TopLeft.X, rectangle->TopRight.X), fmin(rectangle->BottomLeft.X, rectangle->BottomRight.X));
+			collider.MaxX = fmax(fmax(rectangle->TopLeft.X, rectangle->TopRight.X), fmax(rectangle->BottomLeft.X, rectangle->BottomRight.X));
+			collider.MinY = fmin(fmin(rectangle->TopLeft.Y, rectangle->TopRight.Y), fmin(rectangle->BottomLeft.Y, rectangle->BottomRight.Y));
+			collider.MaxY = fmax(fmax(rectangle->TopLeft.Y, rectangle->TopRight.Y), fmax(rectangle->BottomLeft.Y, rectangle->BottomRight.Y));
+			collider.X = center->X;
+			collider.Y = center->Y;
+			collider.AxisX = (rectangle->TopRight.X - rectangle->TopLeft.X) / rectangle->W();
+			collider.AxisY = (rectangle->TopRight.Y - rectangle->TopLeft.Y) / rectangle->W();
+			collider.HalfW = fabs(rectangle->W()) / 2;
+			collider.HalfH = fabs(rectangle->H()) / 2;
+			collider.Radius = 0;
+			_colliders.push_back(collider);
+		}
+		for (k = 0; k < (int)_circleColliders.size(); k++) {
+			CircleF * circle = _circleColliders[k];
+			if (circle->R() <= 0)
+				continue;
+
+			center = circle->GetRotatedCenter();
+			collider.X = center->X;
+			collider.Y = center->Y;
+			collider.Radius = circle->R();
+			collider.MinX = collider.X - collider.Radius;
+			collider.MaxX = collider.X + collider.Radius;
+			collider.MinY = collider.Y - collider.Radius;
+			collider.MaxY = collider.Y + collider.Radius;
+			collider.AxisX = 1;
+			collider.AxisY = 0;
+			collider.HalfW = collider.HalfH = collider.Radius;
+			_colliders.push_back(collider);
+		}
+
+		// Split the particles into chunks that update independently
+		chunks = (_activeP + PARTICLE_CHUNK - 1) / PARTICLE_CHUNK;
+		_jobs.resize(chunks);
+		for (k = 0; k < chunks; k++) {
+			job = &_jobs[k];
+			i = k * PARTICLE_CHUNK;
+
+			job->X = _x + i;
+			job->Y = _y + i;
+			job->VelocityX = _vx + i;
+			job->VelocityY = _vy + i;
+			job->Angle = _angle + i;
+			job->AngleVelocity = _spin + i;
+			job->TTL = _ttl + i;
+			job->Life = _life + i;
+			job->W = _w + i;
+			job->H = _h + i;
+			job->RGBA = _rgba + i;
+			job->Birth = _ballistic ? _birth + i : NULL;
+			job->Count = _activeP - i < PARTICLE_CHUNK ? _activeP - i : PARTICLE_CHUNK;
+			job->DeltaTime = deltaTime;
+			job->Time = _time;
+			job->ClipMinX = clipMinX;
+			job->ClipMinY = clipMinY;
+			job->ClipMaxX = clipMaxX;
+			job->ClipMaxY = clipMaxY;
+			job->GravityX = Gravity.X;
+			job->GravityY = Gravity.Y;
+			job->DragFactor = dragFactor;
+			job->Attractors = Attractors.empty() ? NULL : &Attractors[0];
+			job->AttractorCount = Attractors.size();
+			job->ColorCurve = _useColorCurve ? _colorCurve : NULL;
+			job->AlphaCurve = _useAlphaCurve ? _alphaCurve : NULL;
+			job->SizeCurve = _useSizeCurve ? _sizeCurve : NULL;
+			job->Colliders = _colliders.empty() ? NULL : &_colliders[0];
+			job->ColliderCount = _colliders.size();
+			job->Restitution = Restitution;
+			job->CornersX = _cornersX + i * 4;
+			job->CornersY = _cornersY + i * 4;
+			job->Colors = _colors + i;
+			job->Dead = _dead + i;
+		}
+	}
+
 	void Emitter::Draw(float deltaTime) {
-		int alive;
-
-		// If we're using an image, save all the data values we are about to change
-		float z=0,ix=0,iy=0,iw=0,ih=0,ua=0,ra=0;
-		if (ParticleImage) {
-			z = ParticleImage->ZIndex;
-			ix = ParticleImage->DrawRegion.X();
-			iy = ParticleImage->DrawRegion.Y();
-			iw = ParticleImage->DrawRegion.W();
-			ih = ParticleImage->DrawRegion.H();
-			ra = ParticleImage->DrawRegion.RectangleAngle;
-			ua = ParticleImage->DrawRegion.UseAnchor;
+		Update(deltaTime);
+		Draw();
+	}
+
+	void Emitter::Draw() {
+		int i, k;
+		Mini::BlendMode blend = _mini->GetBlendMode();
+		ParticleJob * job;
+
+		// Pack the visible particles of every chunk into one stream
+		if (_updated) {
+			join();
+
+			_visible = 0;
+			for (k = 0; k < (int)_jobs.size(); k++) {
+				job = &_jobs[k];
+				i = k * PARTICLE_CHUNK;
+
+				if (_visible != i && job->Visible) {
+					memmove(_cornersX + _visible * 4, job->CornersX, job->Visible * 4 * sizeof(float));
+					memmove(_cornersY + _visible * 4, job->CornersY, job->Visible * 4 * sizeof(float));
+					memmove(_colors + _visible, job->Colors, job->Visible * sizeof(unsigned int));
+				}
+
+				_visible += job->Visible;
+			}
+		}
+
+		_mini->SetBlendMode(Blend);
+
+		// The vertices are already rotated, so every particle goes out in one primitive
+		if (ParticleImage)
+			ParticleImage->DrawQuads(_cornersX, _cornersY, _visible, ZIndex, _colors, (RangeDimensionW.Y + RangeDimensionH.Y) / 2);
+		else
+			_mini->DrawRectangleQuads(_cornersX, _cornersY, _visible, ZIndex, _colors);
+
+		_mini->SetBlendMode(blend);
+
+		// Drawing again without an Update only repeats the last frame
+		if (!_updated)
+			return;
+		_updated = 0;
+
+		emit(_pause ? 0 : _deltaTime, Revive && _timeLeft > 0);
+
+		if (!_pause && !_loop)
+			_timeLeft -= _deltaTime;
+
+		// If all the particles have died and no more will spawn, end
+		if (!_live && (EmissionRate <= 0 || (_timeLeft <= 0 && !_loop)))
+			Stop();
+	}
+
+	void Emitter::emit(float deltaTime, bool revive) {
+		int k, d, index;
+		ParticleJob * job;
+
+		// Restart dead particles in place, or queue their slots for reuse
+		for (k = 0; k < (int)_jobs.size(); k++) {
+			job = &_jobs[k];
+			for (d = 0; d < job->DeadCount; d++) {
+				index = job->Dead[d] + k * PARTICLE_CHUNK;
+				if (revive && EmissionRate <= 0) {
+					createParticle(index, _startLocation);
+					continue;
+				}
+
+				_free[(_freeHead + _freeCount) % _maxP] = index;
+				_freeCount++;
+				_live--;
+			}
+			job->DeadCount = 0;
+		}
+
+		if (!_running || EmissionRate <= 0 || deltaTime <= 0 || (_timeLeft <= 0 && !_loop))
+			return;
+
+		// Whole particles are spawned and the remainder carries over to the next step
+		_emitAccumulator += EmissionRate * _rateScale * deltaTime;
+		while (_emitAccumulator >= 1) {
+			if (_freeCount) {
+				index = _free[_freeHead];
+				_freeHead = (_freeHead + 1) % _maxP;
+				_freeCount--;
+			}
+			else if (_activeP < _maxP) {
+				index = _activeP++;
+			}
+			else {
+				// Out of particles, so drop what is owed instead of bursting later
+				_emitAccumulator -= floorf(_emitAccumulator);
+				break;
+			}
+
+			createParticle(index, _startLocation);
+			_live++;
+			_emitAccumulator -= 1;
+		}
+	}
+
+	int Emitter::cull(int count, bool distant, Vector2 focus) {
+		float dx, dy, t;
+		int i;
+
+		join();
+		if (count <= 0 || _live <= 0)
+			return 0;
+
+		// Lower scores are killed first
+		_scores.clear();
+		for (i = 0; i < _activeP; i++) {
+			if (_ttl[i] <= 0)
+				continue;
+			dx = _x[i] - focus.X;
+			dy = _y[i] - focus.Y;
+			if (_ballistic) {
+				t = _time - _birth[i];
+				dx += (_vx[i] + Gravity.X * t / 2) * t;
+				dy += (_vy[i] + Gravity.Y * t / 2) * t;
+			}
+			_scores.push_back(std::make_pair(distant ? -(dx*dx + dy*dy) : _w[i] * _h[i], i));
 		}
 
-		alive = 0;
-		for (std::vector<EmitterParticle>::iterator it = _particles.begin(); it != _particles.end(); it++) {
-			if (it->TTL > 0) {
-				if (!_pause) {
-					it->rect.Location += it->velocity * deltaTime;
-					it->rect.RectangleAngle += it->angleVelocity * deltaTime;
-					it->TTL -= deltaTime;
+		if (count < (int)_scores.size())
+			std::nth_element(_scores.begin(), _scores.begin() + count, _scores.end());
+		else
+			count = _scores.size();
+
+		for (i = 0; i < count; i++) {
+			_ttl[_scores[i].second] = 0;
+			_free[(_freeHead + _freeCount) % _maxP] = _scores[i].second;
+			_freeCount++;
+			_live--;
+		}
+
+		return count;
+	}
+
+	void Emitter::join() {
+		JobSystem * jobs = _mini->GetJobSystem();
+
+		if (jobs && _pending.Pending > 0)
+			jobs->Join(&_pending);
+	}
+
+	void Emitter::UpdateJobs(void * jobs, int start, int end) {
+		for (int i = start; i < end; i++)
+			UpdateJob((ParticleJob *)jobs + i);
+	}
+
+	void Emitter::integrateJob(ParticleJob * job, float * bounds) {
+		const EmitterAttractor * attractor;
+		float dt = job->DeltaTime, x, y, vx, vy, dx, dy, d;
+		int i = 0, k;
+
+		bounds[0] = bounds[1] = 1e30f;
+		bounds[2] = bounds[3] = -1e30f;
+
+#ifdef __ALTIVEC__
+		// Four particles at a time. Chunks start 16 byte aligned; lanes of dead particles are left untouched
+		if (!(((unsigned long)job->X | (unsigned long)job->Y | (unsigned long)job->VelocityX |
+			(unsigned long)job->VelocityY | (unsigned long)job->TTL) & 15)) {
+			__vector float vZero = (__vector float){0,0,0,0};
+			__vector float vOne = (__vector float){1,1,1,1};
+			__vector float vHalf = (__vector float){0.5f,0.5f,0.5f,0.5f};
+			__vector float vThreeHalves = (__vector float){1.5f,1.5f,1.5f,1.5f};
+			__vector float vBig = (__vector float){1e30f,1e30f,1e30f,1e30f};
+			__vector float vDt = (__vector float){dt,dt,dt,dt};
+			__vector float vDrag = (__vector float){job->DragFactor,job->DragFactor,job->DragFactor,job->DragFactor};
+			__vector float vGx = (__vector float){job->GravityX*dt,job->GravityX*dt,job->GravityX*dt,job->GravityX*dt};
+			__vector float vGy = (__vector float){job->GravityY*dt,job->GravityY*dt,job->GravityY*dt,job->GravityY*dt};
+			__vector float vMinX = vBig, vMinY = vBig, vMaxX = vec_sub(vZero, vBig), vMaxY = vMaxX;
+			__vector float vttl, vx0, vy0, vvx, vvy, vdx, vdy, vd, vr, vf, vAx, vAy, vR2, vS;
+			__vector bool int live, near;
+			float lanes[16] __attribute__((aligned(16)));
+
+			for (; (i+4) <= job->Count; i += 4) {
+				vttl = vec_ld(0, job->TTL+i);
+				if (!vec_any_gt(vttl, vZero))
+					continue;
+				live = vec_cmpgt(vttl, vZero);
+
+				vx0 = vec_ld(0, job->X+i);
+				vy0 = vec_ld(0, job->Y+i);
+				vvx = vec_madd(vec_add(vec_ld(0, job->VelocityX+i), vGx), vDrag, vZero);
+				vvy = vec_madd(vec_add(vec_ld(0, job->VelocityY+i), vGy), vDrag, vZero);
+
+				for (k = 0; k < job->AttractorCount; k++) {
+					attractor = &job->Attractors[k];
+					d = attractor->Radius * attractor->Radius;
+					vAx = (__vector float){attractor->X,attractor->X,attractor->X,attractor->X};
+					vAy = (__vector float){attractor->Y,attractor->Y,attractor->Y,attractor->Y};
+					vR2 = (__vector float){d,d,d,d};
+					d = attractor->Strength * dt;
+					vS = (__vector float){d,d,d,d};
+
+					vdx = vec_sub(vAx, vx0);
+					vdy = vec_sub(vAy, vy0);
+					vd = vec_madd(vdx, vdx, vec_madd(vdy, vdy, vZero));
+					near = vec_cmpge(vd, vOne);
+					if (attractor->Radius > 0)
+						near = vec_and(near, vec_cmple(vd, vR2));
+
+					// 1/sqrt(d) from the estimate and one Newton-Raphson step
+					vr = vec_rsqrte(vd);
+					vr = vec_madd(vr, vec_nmsub(vec_madd(vd, vHalf, vZero), vec_madd(vr, vr, vZero), vThreeHalves), vZero);
+					vf = vec_sel(vZero, vec_madd(vS, vr, vZero), near);
+					vvx = vec_madd(vdx, vf, vvx);
+					vvy = vec_madd(vdy, vf, vvy);
 				}
 
-				if (Clip.Contain(&it->rect)) {
-					if (ParticleImage) {
-						ParticleImage->ZIndex = ZIndex;
-						ParticleImage->DrawRegion.X(it->rect.X());
-						ParticleImage->DrawRegion.Y(it->rect.Y());
-						ParticleImage->DrawRegion.W(it->rect.W());
-						ParticleImage->DrawRegion.H(it->rect.H());
-						ParticleImage->DrawRegion.RectangleAngle = it->rect.RectangleAngle;
-						ParticleImage->DrawRegion.UseAnchor = 0;
-						ParticleImage->Draw(it->RGBA);
+				vvx = vec_sel(vec_ld(0, job->VelocityX+i), vvx, live);
+				vvy = vec_sel(vec_ld(0, job->VelocityY+i), vvy, live);
+				vx0 = vec_sel(vx0, vec_madd(vvx, vDt, vx0), live);
+				vy0 = vec_sel(vy0, vec_madd(vvy, vDt, vy0), live);
+				vec_st(vvx, 0, job->VelocityX+i);
+				vec_st(vvy, 0, job->VelocityY+i);
+				vec_st(vx0, 0, job->X+i);
+				vec_st(vy0, 0, job->Y+i);
+
+				vMinX = vec_min(vMinX, vec_sel(vBig, vx0, live));
+				vMinY = vec_min(vMinY, vec_sel(vBig, vy0, live));
+				vMaxX = vec_max(vMaxX, vec_sel(vec_sub(vZero, vBig), vx0, live));
+				vMaxY = vec_max(vMaxY, vec_sel(vec_sub(vZero, vBig), vy0, live));
+			}
+
+			// Reduce the lanes of each bound
+			vec_st(vMinX, 0, lanes);
+			vec_st(vMinY, 16, lanes);
+			vec_st(vMaxX, 32, lanes);
+			vec_st(vMaxY, 48, lanes);
+			for (k = 0; k < 4; k++) {
+				if (lanes[k] < bounds[0]) bounds[0] = lanes[k];
+				if (lanes[4+k] < bounds[1]) bounds[1] = lanes[4+k];
+				if (lanes[8+k] > bounds[2]) bounds[2] = lanes[8+k];
+				if (lanes[12+k] > bounds[3]) bounds[3] = lanes[12+k];
+			}
+		}
+#endif
+
+		// Scalar fallback and remainder. Affectors change velocity, then velocity moves the particle
+		for (; i < job->Count; i++) {
+			if (job->TTL[i] <= 0)
+				continue;
+
+			vx = (job->VelocityX[i] + job->GravityX * dt) * job->DragFactor;
+			vy = (job->VelocityY[i] + job->GravityY * dt) * job->DragFactor;
+			for (k = 0; k < job->AttractorCount; k++) {
+				attractor = &job->Attractors[k];
+				dx = attractor->X - job->X[i];
+				dy = attractor->Y - job->Y[i];
+				d = dx*dx + dy*dy;
+				if (d < 1 || (attractor->Radius > 0 && d > attractor->Radius * attractor->Radius))
+					continue;
+				d = attractor->Strength * dt / sqrtf(d);
+				vx += dx * d;
+				vy += dy * d;
+			}
+			job->VelocityX[i] = vx;
+			job->VelocityY[i] = vy;
+			x = job->X[i] += vx * dt;
+			y = job->Y[i] += vy * dt;
+
+			if (x < bounds[0]) bounds[0] = x;
+			if (y < bounds[1]) bounds[1] = y;
+			if (x > bounds[2]) bounds[2] = x;
+			if (y > bounds[3]) bounds[3] = y;
+		}
+	}
+
+	void Emitter::collideJob(ParticleJob * job, const float * bounds) {
+		const ParticleCollider * collider;
+		float x, y, vx, vy, dx, dy, d, nx, ny, lx, ly, px, py, side;
+		int nearby[EMITTER_JOB_COLLIDERS];
+		int i = 0, k, n, nearCount = 0;
+		bool all = 0;
+
+		// Chunk level reject: particles only test colliders whose bounds overlap the chunk's
+		for (k = 0; k < job->ColliderCount && !all; k++) {
+			collider = &job->Colliders[k];
+			if (bounds[2] < collider->MinX || bounds[0] > collider->MaxX || bounds[3] < collider->MinY || bounds[1] > collider->MaxY)
+				continue;
+			if (nearCount == EMITTER_JOB_COLLIDERS)
+				all = 1;
+			else
+				nearby[nearCount++] = k;
+		}
+		if (all)
+			nearCount = job->ColliderCount;
+		if (!nearCount)
+			return;
+
+		// Only the end position is tested, so a particle that moves past a collider within one step goes through it
+#ifdef __ALTIVEC__
+		// Four particles at a time, each collider's push-out and bounce applied to the lanes it hit
+		if (!(((unsigned long)job->X | (unsigned long)job->Y | (unsigned long)job->VelocityX |
+			(unsigned long)job->VelocityY | (unsigned long)job->TTL) & 15)) {
+			__vector float vZero = (__vector float){0,0,0,0};
+			__vector float vOne = (__vector float){1,1,1,1};
+			__vector float vHalf = (__vector float){0.5f,0.5f,0.5f,0.5f};
+			__vector float vThreeHalves = (__vector float){1.5f,1.5f,1.5f,1.5f};
+			__vector float vBounce = (__vector float){1+job->Restitution,1+job->Restitution,1+job->Restitution,1+job->Restitution};
+			__vector float vx4, vy4, vvx, vvy, vdx, vdy, vd, vr, vnx, vny, vlx, vly, vpx, vpy, vsx, vsy;
+			__vector float vMinX, vMinY, vMaxX, vMaxY, vCx, vCy, vAx, vAy, vHw, vHh, vRadius;
+			__vector bool int live, hit, edge;
+
+			for (; (i+4) <= job->Count; i += 4) {
+				live = vec_cmpgt(vec_ld(0, job->TTL+i), vZero);
+				vx4 = vec_ld(0, job->X+i);
+				vy4 = vec_ld(0, job->Y+i);
+				vvx = vec_ld(0, job->VelocityX+i);
+				vvy = vec_ld(0, job->VelocityY+i);
+
+				for (n = 0; n < nearCount; n++) {
+					collider = &job->Colliders[all ? n : nearby[n]];
+					vMinX = (__vector float){collider->MinX,collider->MinX,collider->MinX,collider->MinX};
+					vMinY = (__vector float){collider->MinY,collider->MinY,collider->MinY,collider->MinY};
+					vMaxX = (__vector float){collider->MaxX,collider->MaxX,collider->MaxX,collider->MaxX};
+					vMaxY = (__vector float){collider->MaxY,collider->MaxY,collider->MaxY,collider->MaxY};
+					hit = vec_and(vec_and(live, vec_and(vec_cmpge(vx4, vMinX), vec_cmple(vx4, vMaxX))),
+						vec_and(vec_cmpge(vy4, vMinY), vec_cmple(vy4, vMaxY)));
+					if (!vec_any_ne(hit, (__vector bool int)vZero))
+						continue;
+
+					vCx = (__vector float){collider->X,collider->X,collider->X,collider->X};
+					vCy = (__vector float){collider->Y,collider->Y,collider->Y,collider->Y};
+					vdx = vec_sub(vx4, vCx);
+					vdy = vec_sub(vy4, vCy);
+					if (collider->Radius > 0) {
+						vRadius = (__vector float){collider->Radius,collider->Radius,collider->Radius,collider->Radius};
+						vd = vec_madd(vdx, vdx, vec_madd(vdy, vdy, vZero));
+						hit = vec_and(hit, vec_cmplt(vd, vec_madd(vRadius, vRadius, vZero)));
+
+						// Normal from 1/sqrt(d) (estimate and one Newton-Raphson step). Straight up from the center
+						vr = vec_rsqrte(vd);
+						vr = vec_madd(vr, vec_nmsub(vec_madd(vd, vHalf, vZero), vec_madd(vr, vr, vZero), vThreeHalves), vZero);
+						edge = vec_cmpgt(vd, vZero);
+						vnx = vec_sel(vZero, vec_madd(vdx, vr, vZero), edge);
+						vny = vec_sel(vec_sub(vZero, vOne), vec_madd(vdy, vr, vZero), edge);
+						vx4 = vec_sel(vx4, vec_madd(vnx, vRadius, vCx), hit);
+						vy4 = vec_sel(vy4, vec_madd(vny, vRadius, vCy), hit);
 					}
 					else {
-						_mini->DrawRectangle(it->rect.X(), it->rect.Y(),
-											it->rect.X(), it->rect.Y(), ZIndex,
-											it->rect.W(), it->rect.H(),
-											it->RGBA, it->rect.RectangleAngle);
+						// Distance inside each pair of edges, in the rectangle's own axes
+						vAx = (__vector float){collider->AxisX,collider->AxisX,collider->AxisX,collider->AxisX};
+						vAy = (__vector float){collider->AxisY,collider->AxisY,collider->AxisY,collider->AxisY};
+						vHw = (__vector float){collider->HalfW,collider->HalfW,collider->HalfW,collider->HalfW};
+						vHh = (__vector float){collider->HalfH,collider->HalfH,collider->HalfH,collider->HalfH};
+						vlx = vec_madd(vdx, vAx, vec_madd(vdy, vAy, vZero));
+						vly = vec_nmsub(vdx, vAy, vec_madd(vdy, vAx, vZero));
+						vpx = vec_sub(vHw, vec_abs(vlx));
+						vpy = vec_sub(vHh, vec_abs(vly));
+						hit = vec_and(hit, vec_and(vec_cmpgt(vpx, vZero), vec_cmpgt(vpy, vZero)));
 
+						// Leave through the nearest edge
+						vsx = vec_sel(vOne, vec_sub(vZero, vOne), vec_cmplt(vlx, vZero));
+						vsy = vec_sel(vOne, vec_sub(vZero, vOne), vec_cmplt(vly, vZero));
+						edge = vec_cmplt(vpx, vpy);
+						vnx = vec_sel(vec_sub(vZero, vec_madd(vAy, vsy, vZero)), vec_madd(vAx, vsx, vZero), edge);
+						vny = vec_sel(vec_madd(vAx, vsy, vZero), vec_madd(vAy, vsx, vZero), edge);
+						vd = vec_sel(vpy, vpx, edge);
+						vx4 = vec_sel(vx4, vec_madd(vnx, vd, vx4), hit);
+						vy4 = vec_sel(vy4, vec_madd(vny, vd, vy4), hit);
 					}
+
+					// Vector2::Reflect, with the part along the normal scaled by Restitution
+					vd = vec_madd(vvx, vnx, vec_madd(vvy, vny, vZero));
+					hit = vec_and(hit, vec_cmplt(vd, vZero));
+					vd = vec_madd(vd, vBounce, vZero);
+					vvx = vec_sel(vvx, vec_nmsub(vd, vnx, vvx), hit);
+					vvy = vec_sel(vvy, vec_nmsub(vd, vny, vvy), hit);
+				}
+
+				vec_st(vx4, 0, job->X+i);
+				vec_st(vy4, 0, job->Y+i);
+				vec_st(vvx, 0, job->VelocityX+i);
+				vec_st(vvy, 0, job->VelocityY+i);
+			}
+		}
+#endif
+
+		// Scalar fallback and remainder
+		for (; i < job->Count; i++) {
+			if (job->TTL[i] <= 0)
+				continue;
+
+			x = job->X[i];
+			y = job->Y[i];
+			vx = job->VelocityX[i];
+			vy = job->VelocityY[i];
+
+			for (n = 0; n < nearCount; n++) {
+				collider = &job->Colliders[all ? n : nearby[n]];
+				if (x < collider->MinX || x > collider->MaxX || y < collider->MinY || y > collider->MaxY)
+					continue;
+
+				dx = x - collider->X;
+				dy = y - collider->Y;
+				if (collider->Radius > 0) {
+					d = dx*dx + dy*dy;
+					if (d >= collider->Radius * collider->Radius)
+						continue;
+
+					d = sqrtf(d);
+					nx = d > 0 ? dx / d : 0;
+					ny = d > 0 ? dy / d : -1;
+					x = collider->X + nx * collider->Radius;
+					y = collider->Y + ny * collider->Radius;
 				}
 				else {
-					//printf("r(%.2f,%.2f,%.2f,%.2f) 0x%08x\n", it->rect.X(), it->rect.Y(), it->rect.W(), it->rect.H(), it->RGBA);
+					// Distance inside each pair of edges, in the rectangle's own axes
+					lx = dx * collider->AxisX + dy * collider->AxisY;
+					ly = dy * collider->AxisX - dx * collider->AxisY;
+					px = collider->HalfW - fabs(lx);
+					py = collider->HalfH - fabs(ly);
+					if (px <= 0 || py <= 0)
+						continue;
+
+					// Leave through the nearest edge
+					if (px < py) {
+						side = lx < 0 ? -1 : 1;
+						nx = collider->AxisX * side;
+						ny = collider->AxisY * side;
+						d = px;
+					}
+					else {
+						side = ly < 0 ? -1 : 1;
+						nx = -collider->AxisY * side;
+						ny = collider->AxisX * side;
+						d = py;
+					}
+					x += nx * d;
+					y += ny * d;
 				}
 
-				alive++;
-			}
-			else if (Revive && _timeLeft > 0) {
-				it = _particles.erase(it);
-				it--;
-				createParticle(_startLocation);
-				alive++;
+				// Vector2::Reflect, with the part along the normal scaled by Restitution
+				d = vx * nx + vy * ny;
+				if (d < 0) {
+					vx -= (1 + job->Restitution) * d * nx;
+					vy -= (1 + job->Restitution) * d * ny;
+				}
 			}
+
+			job->VelocityX[i] = vx;
+			job->VelocityY[i] = vy;
+			job->X[i] = x;
+			job->Y[i] = y;
 		}
+	}
 
-		if (!_pause && !_loop)
-			_timeLeft -= deltaTime;
+	void Emitter::UpdateJob(void * data) {
+		ParticleJob * job = (ParticleJob *)data;
+		float dt = job->DeltaTime, t, c, s, ax, ay, bx, by, ex, ey, x, y, w, h, ttl, angle;
+		float multipliers[4], bounds[4];
+		unsigned int rgba;
+		int i, index, visible = 0, alive = 0, dead = 0;
 
-		// If all the particles have died, end
-		if (!alive)
-			Stop();
+		if (!job->Birth) {
+			integrateJob(job, bounds);
+			if (job->ColliderCount)
+				collideJob(job, bounds);
+		}
+
+		for (i = 0; i < job->Count; i++) {
+			if (job->TTL[i] <= 0)
+				continue;
+			alive++;
+
+			if (job->Birth) {
+				// Evaluate the spawn state at the current time. Nothing is written back until the particle dies
+				t = job->Time - job->Birth[i];
+				x = job->X[i] + (job->VelocityX[i] + job->GravityX * t / 2) * t;
+				y = job->Y[i] + (job->VelocityY[i] + job->GravityY * t / 2) * t;
+				angle = job->Angle[i] + job->AngleVelocity[i] * t;
+				ttl = job->Life[i] - t;
+				if (ttl <= 0) {
+					job->TTL[i] = 0;
+					job->Dead[dead++] = i;
+				}
+				goto draw;
+			}
+
+			x = job->X[i];
+			y = job->Y[i];
+			job->Angle[i] += job->AngleVelocity[i] * dt;
+			job->TTL[i] -= dt;
+			if (job->TTL[i] <= 0)
+				job->Dead[dead++] = i;
+			angle = job->Angle[i];
+			ttl = job->TTL[i];
 
-		if (ParticleImage) {
-			ParticleImage->ZIndex = z;
-			ParticleImage->DrawRegion.X(ix);
-			ParticleImage->DrawRegion.Y(iy);
-			ParticleImage->DrawRegion.W(iw);
-			ParticleImage->DrawRegion.H(ih);
-			ParticleImage->DrawRegion.RectangleAngle = ra;
-			ParticleImage->DrawRegion.UseAnchor = ua;
+		draw:
+			index = curveIndex(ttl, job->Life[i]);
+			w = job->W[i];
+			h = job->H[i];
+			if (job->SizeCurve) {
+				w *= job->SizeCurve[index];
+				h *= job->SizeCurve[index];
+			}
+
+			// Half width and half height axes, rotated the way RectangleF rotates its corners
+			t = -angle * (float)(PI / 180.0);
+			c = cosf(t);
+			s = sinf(t);
+			ax = c * w / 2;
+			ay = -s * w / 2;
+			bx = s * h / 2;
+			by = c * h / 2;
+
+			// Skip particles whose bounds miss the clip region
+			ex = fabs(ax) + fabs(bx);
+			ey = fabs(ay) + fabs(by);
+			if (x + ex < job->ClipMinX || x - ex > job->ClipMaxX || y + ey < job->ClipMinY || y - ey > job->ClipMaxY)
+				continue;
+
+			rgba = job->RGBA[i];
+			if (job->ColorCurve || job->AlphaCurve) {
+				multipliers[0] = multipliers[1] = multipliers[2] = multipliers[3] = 1;
+				if (job->ColorCurve) {
+					multipliers[0] = job->ColorCurve[index*4+0];
+					multipliers[1] = job->ColorCurve[index*4+1];
+					multipliers[2] = job->ColorCurve[index*4+2];
+					multipliers[3] = job->ColorCurve[index*4+3];
+				}
+				if (job->AlphaCurve)
+					multipliers[3] *= job->AlphaCurve[index];
+
+				rgba = ((unsigned int)(((rgba >> 24) & 0xFF) * multipliers[0]) << 24) |
+						((unsigned int)(((rgba >> 16) & 0xFF) * multipliers[1]) << 16) |
+						((unsigned int)(((rgba >> 8) & 0xFF) * multipliers[2]) << 8) |
+						(unsigned int)((rgba & 0xFF) * multipliers[3]);
+			}
+
+			job->CornersX[visible*4+0] = x - ax - bx; job->CornersY[visible*4+0] = y - ay - by;
+			job->CornersX[visible*4+1] = x + ax - bx; job->CornersY[visible*4+1] = y + ay - by;
+			job->CornersX[visible*4+2] = x + ax + bx; job->CornersY[visible*4+2] = y + ay + by;
+			job->CornersX[visible*4+3] = x - ax + bx; job->CornersY[visible*4+3] = y - ay + by;
+			job->Colors[visible] = rgba;
+			visible++;
 		}
+
+		job->Visible = visible;
+		job->Alive = alive;
+		job->DeadCount = dead;
 	}
 
-	void Emitter::createParticle(Vector2 location) {
-		char r,g,b,a;
-		float c,s,x,y,t;
+	int Emitter::curveIndex(float ttl, float life) {
+		float t = life > 0 ? 1 - ttl / life : 1;
 
-		EmitterParticle particle = EmitterParticle();
+		if (t <= 0)
+			return 0;
+		if (t >= 1)
+			return EMITTER_CURVE_SIZE - 1;
+		return (int)(t * (EMITTER_CURVE_SIZE - 1) + 0.5f);
+	}
 
-		// Knows to draw and to revive when dead
-		particle.spawn = 1;
+	void Emitter::createParticle(int index, Vector2 location) {
+		char r,g,b,a;
+		float c,s,x,y,t;
 
 		// Generate random attributes
-		particle.TTL = randomRange(RangeTTL.X, RangeTTL.Y);
+		_ttl[index] = randomRange(RangeTTL.X, RangeTTL.Y);
+		_life[index] = _ttl[index];
+		_birth[index] = _time;
 
 		r = (char)randomRange(RangeColorRed.X,RangeColorRed.Y); if (r<0) {r=0;} else if (r>255) {r=255;}
 		g = (char)randomRange(RangeColorGreen.X,RangeColorGreen.Y); if (g<0) {g=0;} else if (g>255) {g=255;}
 		b = (char)randomRange(RangeColorBlue.X,RangeColorBlue.Y); if (b<0) {b=0;} else if (b>255) {b=255;}
 		a = (char)randomRange(RangeColorAlpha.X,RangeColorAlpha.Y); if (a<0) {a=0;} else if (a>255) {a=255;}
-		particle.RGBA = (r<<24) | (g<<16) | (b<<8) | a;
+		_rgba[index] = (r<<24) | (g<<16) | (b<<8) | a;
 
-		particle.rect.X(randomRange(RangeStartX.X, RangeStartX.Y) + location.X);
-		particle.rect.Y(randomRange(RangeStartY.X, RangeStartX.Y) + location.Y);
-		particle.rect.W(randomRange(RangeDimensionW.X, RangeDimensionW.Y));
-		particle.rect.H(randomRange(RangeDimensionH.X, RangeDimensionH.Y));
+		_x[index] = randomRange(RangeStartX.X, RangeStartX.Y) + location.X;
+		_y[index] = randomRange(RangeStartY.X, RangeStartX.Y) + location.Y;
+		_w[index] = randomRange(RangeDimensionW.X, RangeDimensionW.Y);
+		_h[index] = randomRange(RangeDimensionH.X, RangeDimensionH.Y);
+		_angle[index] = 0;
 
 
 		t = DEG2RAD(randomRange(RangeVelocityTheta.X, RangeVelocityTheta.Y));
@@ -233,18 +914,87 @@ namespace Mini2D {
 		y = -x;
 
 
-		particle.velocity.Set(c*x, s*x);
+		_vx[index] = c*x;
+		_vy[index] = s*x;
 
-		particle.angleVelocity = randomRange(RangeRotation.X, RangeRotation.Y);
+		_spin[index] = randomRange(RangeRotation.X, RangeRotation.Y);
+	}
 
-		_particles.push_back(particle);
+	//---------------------------------------------------------------------------
+	// Affector Functions
+	//---------------------------------------------------------------------------
+	void Emitter::SetColorCurve(const unsigned int * rgba, int count) {
+		std::vector<float> keys;
+		int i;
+
+		join();
+		_useColorCurve = rgba && count > 0;
+		if (!_useColorCurve)
+			return;
+
+		keys.resize(count * 4);
+		for (i = 0; i < count; i++) {
+			keys[i*4+0] = ((rgba[i] >> 24) & 0xFF) / 255.f;
+			keys[i*4+1] = ((rgba[i] >> 16) & 0xFF) / 255.f;
+			keys[i*4+2] = ((rgba[i] >> 8) & 0xFF) / 255.f;
+			keys[i*4+3] = (rgba[i] & 0xFF) / 255.f;
+		}
+		resampleCurve(&keys[0], count, 4, _colorCurve);
+	}
+
+	void Emitter::SetAlphaCurve(const float * alpha, int count) {
+		join();
+		_useAlphaCurve = alpha && count > 0;
+		if (_useAlphaCurve)
+			resampleCurve(alpha, count, 1, _alphaCurve);
+	}
+
+	void Emitter::SetSizeCurve(const float * scale, int count) {
+		join();
+		_useSizeCurve = scale && count > 0;
+		if (_useSizeCurve)
+			resampleCurve(scale, count, 1, _sizeCurve);
+	}
+
+	void Emitter::resampleCurve(const float * keys, int count, int channels, float * table) {
+		int i, c, key;
+		float t, f;
+
+		for (i = 0; i < EMITTER_CURVE_SIZE; i++) {
+			// Position of this entry between keys, linearly interpolated
+			t = count > 1 ? (float)i * (count - 1) / (EMITTER_CURVE_SIZE - 1) : 0;
+			key = (int)t;
+			if (key >= count - 1)
+				key = count > 1 ? count - 2 : 0;
+			f = count > 1 ? t - key : 0;
+
+			for (c = 0; c < channels; c++)
+				table[i*channels+c] = count > 1 ? keys[key*channels+c] * (1 - f) + keys[(key+1)*channels+c] * f : keys[c];
+		}
+	}
+
+	void Emitter::AddCollider(RectangleF * rectangle) {
+		if (rectangle)
+			_rectangleColliders.push_back(rectangle);
+	}
+
+	void Emitter::AddCollider(CircleF * circle) {
+		if (circle)
+			_circleColliders.push_back(circle);
+	}
+
+	void Emitter::ClearColliders() {
+		join();
+		_rectangleColliders.clear();
+		_circleColliders.clear();
+		_colliders.clear();
 	}
 
 	//---------------------------------------------------------------------------
 	// Status Functions
 	//---------------------------------------------------------------------------
 	Emitter::EmitterStatus Emitter::Status() {
-		if (_activeP <= 0)
+		if (!_running)
 			return EMITTER_DEAD;
 		if (_pause)
 			return EMITTER_PAUSED;
@@ -252,23 +1002,41 @@ namespace Mini2D {
 	}
 
 	void Emitter::Pause() {
-		if (_activeP > 0)
+		if (_running)
 			_pause = 1;
 	}
 
 	void Emitter::Resume() {
-		if (_activeP > 0)
+		if (_running)
 			_pause = 0;
 	}
 
+	int Emitter::GetLiveCount() {
+		return _live;
+	}
+
+	int Emitter::GetVisibleCount() {
+		return _visible;
+	}
+
+	int Emitter::GetMaxParticles() {
+		return _maxP;
+	}
+
 	void Emitter::Stop() {
+		join();
 		_timeLeft = 0;
-		if (_activeP <= 0)
+		_loop = 0;
+		if (!_running)
 			return;
 
 		// clean up
-		_particles.clear();
+		_running = 0;
 		_activeP = 0;
+		_live = 0;
+		_freeCount = 0;
+		_visible = 0;
+		_updated = 0;
 	}
 
 	//---------------------------------------------------------------------------
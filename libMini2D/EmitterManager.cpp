@@ -0,0 +1,176 @@
+/*
+ * EmitterManager.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <math.h>                                // sqrtf
+#include <string.h>                              // memset
+
+#include <Mini2D/EmitterManager.hpp>             // Class definition
+
+namespace Mini2D {
+
+	double timeMs();
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	EmitterManager::EmitterManager(Mini * mini, unsigned int budget) : _mini(mini) {
+		Budget = budget;
+		Cull = CULL_SMALLEST;
+		Focus.Set(mini->MAXW / 2, mini->MAXH / 2);
+		LodDistance = 0;
+		_live = 0;
+	}
+
+	EmitterManager::~EmitterManager() {
+		unsigned int i;
+
+		for (i = 0; i < _emitters.size(); i++)
+			delete _emitters[i];
+		_emitters.clear();
+		_costs.clear();
+		_mini = NULL;
+	}
+
+	//---------------------------------------------------------------------------
+	// Emitter Functions
+	//---------------------------------------------------------------------------
+	Emitter * EmitterManager::Add(unsigned int maxParticles) {
+		Emitter * emitter = new Emitter(_mini, maxParticles);
+		EmitterCost cost;
+
+		memset(&cost, 0, sizeof(EmitterCost));
+		cost.RateScale = 1;
+
+		_emitters.push_back(emitter);
+		_costs.push_back(cost);
+		return emitter;
+	}
+
+	void EmitterManager::Remove(Emitter * emitter) {
+		unsigned int i;
+
+		for (i = 0; i < _emitters.size(); i++) {
+			if (_emitters[i] == emitter) {
+				delete emitter;
+				_emitters.erase(_emitters.begin() + i);
+				_costs.erase(_costs.begin() + i);
+				return;
+			}
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Draw Functions
+	//---------------------------------------------------------------------------
+	void EmitterManager::Update(float deltaTime) {
+		float demand = 0, scale = 1, lod, dx, dy, d;
+		unsigned int i, live = 0;
+		Emitter * emitter;
+		double t;
+
+		// Particles the emitters would spawn this frame against the room left in the budget
+		for (i = 0; i < _emitters.size(); i++) {
+			emitter = _emitters[i];
+			live += emitter->GetLiveCount();
+
+			lod = 1;
+			if (LodDistance > 0) {
+				dx = emitter->_startLocation.X - Focus.X;
+				dy = emitter->_startLocation.Y - Focus.Y;
+				d = sqrtf(dx*dx + dy*dy);
+				if (d > LodDistance)
+					lod = LodDistance / d;
+			}
+			_costs[i].RateScale = lod;
+
+			if (emitter->Status() && emitter->EmissionRate > 0)
+				demand += emitter->EmissionRate * lod * deltaTime;
+		}
+
+		if (Budget && demand > 0)
+			scale = live >= Budget ? 0 : fmin((Budget - live) / demand, 1);
+
+		// Every emitter forks its jobs before any is waited on
+		for (i = 0; i < _emitters.size(); i++) {
+			emitter = _emitters[i];
+			_costs[i].RateScale *= scale;
+			emitter->_rateScale = _costs[i].RateScale;
+
+			t = timeMs();
+			if (emitter->Status())
+				emitter->Update(deltaTime);
+			_costs[i].Time = timeMs() - t;
+		}
+	}
+
+	void EmitterManager::Draw(float deltaTime) {
+		Update(deltaTime);
+		Draw();
+	}
+
+	void EmitterManager::Draw() {
+		unsigned int i;
+		int live = 0, excess, share;
+		Emitter * emitter;
+		double t;
+
+		for (i = 0; i < _emitters.size(); i++) {
+			emitter = _emitters[i];
+
+			t = timeMs();
+			if (emitter->Status())
+				emitter->Draw();
+			_costs[i].Time += timeMs() - t;
+
+			_costs[i].Visible = emitter->Status() ? emitter->GetVisibleCount() : 0;
+			_costs[i].Culled = 0;
+			live += emitter->GetLiveCount();
+		}
+
+		// Kill a share of the excess from each emitter, in proportion to its particles
+		excess = Budget ? live - (int)Budget : 0;
+		for (i = 0; i < _emitters.size() && excess > 0; i++) {
+			emitter = _emitters[i];
+			share = (int)ceilf((float)excess * emitter->GetLiveCount() / live);
+			_costs[i].Culled = emitter->cull(share, Cull == CULL_DISTANT, Focus);
+		}
+
+		_live = 0;
+		for (i = 0; i < _emitters.size(); i++) {
+			_costs[i].Live = _emitters[i]->GetLiveCount();
+			_live += _costs[i].Live;
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Get Functions
+	//---------------------------------------------------------------------------
+	int EmitterManager::GetEmitterCount() {
+		return _emitters.size();
+	}
+
+	Emitter * EmitterManager::GetEmitter(int index) {
+		if (index < 0 || index >= (int)_emitters.size())
+			return NULL;
+		return _emitters[index];
+	}
+
+	EmitterManager::EmitterCost EmitterManager::GetCost(int index) {
+		EmitterCost cost;
+
+		if (index < 0 || index >= (int)_costs.size()) {
+			memset(&cost, 0, sizeof(EmitterCost));
+			return cost;
+		}
+		return _costs[index];
+	}
+
+	int EmitterManager::GetLiveCount() {
+		return _live;
+	}
+
+}
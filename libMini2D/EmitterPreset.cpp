@@ -0,0 +1,651 @@
+/*
+ * EmitterPreset.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <stdio.h>                               // fopen, snprintf
+#include <stdlib.h>                              // strtod, strtoul
+#include <math.h>                                // isfinite
+#include <string.h>                              // strcmp, memcpy
+#include <ctype.h>                               // isspace
+#include <stdarg.h>                              // va_list
+#include <sys/stat.h>                            // stat
+
+#include <Mini2D/EmitterPreset.hpp>              // Class definition
+
+#define PRESET_COLOR_KEYS   0                    // Curve order in the binary format
+#define PRESET_ALPHA_KEYS   1
+#define PRESET_SIZE_KEYS    2
+
+namespace Mini2D {
+
+	typedef struct _presetVector_t {
+		const char * Name;
+		Vector2 Emitter::* Field;
+		float Min, Max;                          // Emitter default
+	} PresetVector;
+
+	typedef struct _presetFloat_t {
+		const char * Name;
+		float Emitter::* Field;
+		float Default;
+	} PresetFloat;
+
+	typedef struct _presetFlag_t {
+		const char * Name;
+		bool Emitter::* Field;
+	} PresetFlag;
+
+	// Settings set by name. The order is the binary layout, so new entries go at the end with a PRESET_VERSION bump
+	static const PresetVector presetVectors[] = {
+		{ "RangeVelocityTheta", &Emitter::RangeVelocityTheta, 0, 360 },
+		{ "RangeVelocity", &Emitter::RangeVelocity, 0, 10 },
+		{ "RangeStartX", &Emitter::RangeStartX, 0, 0 },
+		{ "RangeStartY", &Emitter::RangeStartY, 0, 0 },
+		{ "RangeDimensionW", &Emitter::RangeDimensionW, 10, 50 },
+		{ "RangeDimensionH", &Emitter::RangeDimensionH, 10, 50 },
+		{ "RangeTTL", &Emitter::RangeTTL, 5, 20 },
+		{ "RangeRotation", &Emitter::RangeRotation, 0, 0 },
+		{ "RangeColorRed", &Emitter::RangeColorRed, 0, 255 },
+		{ "RangeColorGreen", &Emitter::RangeColorGreen, 0, 255 },
+		{ "RangeColorBlue", &Emitter::RangeColorBlue, 0, 255 },
+		{ "RangeColorAlpha", &Emitter::RangeColorAlpha, 255, 255 },
+		{ "Gravity", &Emitter::Gravity, 0, 0 }
+	};
+
+	static const PresetFloat presetFloats[] = {
+		{ "ZIndex", &Emitter::ZIndex, 0 },
+		{ "EmissionRate", &Emitter::EmissionRate, 0 },
+		{ "Drag", &Emitter::Drag, 0 },
+		{ "Restitution", &Emitter::Restitution, 0.5f }
+	};
+
+	static const PresetFlag presetFlags[] = {
+		{ "Revive", &Emitter::Revive },
+		{ "SkipExplosion", &Emitter::SkipExplosion },
+		{ "Ballistic", &Emitter::Ballistic }
+	};
+
+	static const char * presetBlends[] = { "normal", "additive", "multiply" };
+
+	#define PRESET_VECTORS  (int)(sizeof(presetVectors) / sizeof(presetVectors[0]))
+	#define PRESET_FLOATS   (int)(sizeof(presetFloats) / sizeof(presetFloats[0]))
+	#define PRESET_FLAGS    (int)(sizeof(presetFlags) / sizeof(presetFlags[0]))
+	#define PRESET_BLENDS   (int)(sizeof(presetBlends) / sizeof(presetBlends[0]))
+
+	// Reads whitespace separated decimal numbers. Returns false if text holds anything else or a number isn't finite
+	static bool readFloats(const char * text, std::vector<float> * values);
+
+	// Reads whitespace separated hexadecimal colors. Returns false if text holds anything else
+	static bool readColors(const char * text, std::vector<unsigned int> * colors);
+
+	// Reads a big endian word from the binary format, advancing data. Returns false past end (or on a float that isn't finite)
+	static bool readWord(const unsigned char ** data, const unsigned char * end, unsigned int * value);
+	static bool readFloat(const unsigned char ** data, const unsigned char * end, float * value);
+
+	// Appends a big endian word to the binary format
+	static void writeWord(std::vector<unsigned char> * out, unsigned int value);
+	static void writeFloat(std::vector<unsigned char> * out, float value);
+
+	// Appends a formatted line to the text format
+	static void writeLine(std::string * out, const char * format, ...);
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	EmitterPreset::EmitterPreset() {
+		defaults(&_settings);
+		_modified = 0;
+		_version = 0;
+	}
+
+	EmitterPreset::~EmitterPreset() {
+
+	}
+
+	//---------------------------------------------------------------------------
+	// Load Functions
+	//---------------------------------------------------------------------------
+	EmitterPreset::PresetLoadStatus EmitterPreset::Load(const char * filepath) {
+		PresetLoadStatus status;
+		struct stat info;
+		unsigned char * data;
+		FILE * file;
+		long size;
+
+		if (!filepath || stat(filepath, &info))
+			return PRESET_INVALID_ARG;
+
+		file = fopen(filepath, "rb");
+		if (!file)
+			return PRESET_INVALID_ARG;
+		fseek(file, 0, SEEK_END);
+		size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		if (size <= 0) {
+			fclose(file);
+			return PRESET_INVALID_ARG;
+		}
+
+		data = (unsigned char*)malloc(size);
+		if (!data || fread(data, 1, size, file) != (size_t)size) {
+			fclose(file);
+			if (data)
+				free(data);
+			return data ? PRESET_INVALID_ARG : PRESET_NO_MEM;
+		}
+		fclose(file);
+
+		status = Load(data, size);
+		free(data);
+
+		if (status == PRESET_SUCCESS) {
+			_path = filepath;
+			_modified = info.st_mtime;
+		}
+		return status;
+	}
+
+	EmitterPreset::PresetLoadStatus EmitterPreset::Load(const void * buffer, unsigned int size) {
+		const unsigned char * data = (const unsigned char *)buffer;
+		PresetSettings settings;
+		PresetLoadStatus status;
+
+		if (!data || !size)
+			return PRESET_INVALID_ARG;
+
+		// Parse into a copy so a bad edit keeps the working settings
+		defaults(&settings);
+		if (size >= 4 && ((data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3]) == PRESET_MAGIC)
+			status = parseBinary(data, size, &settings);
+		else
+			status = parseText((const char *)data, size, &settings);
+		if (status != PRESET_SUCCESS)
+			return status;
+
+		_settings = settings;
+		_path.clear();
+		_modified = 0;
+		_version++;
+		return PRESET_SUCCESS;
+	}
+
+	bool EmitterPreset::Save(const char * filepath, bool binary) {
+		std::vector<unsigned char> data;
+		std::string text;
+		const void * out;
+		size_t size;
+		FILE * file;
+
+		if (!filepath)
+			return 0;
+
+		if (binary) {
+			writeBinary(&_settings, &data);
+			out = &data[0];
+			size = data.size();
+		}
+		else {
+			writeText(&_settings, &text);
+			out = text.c_str();
+			size = text.size();
+		}
+
+		file = fopen(filepath, "wb");
+		if (!file)
+			return 0;
+		size = fwrite(out, 1, size, file) == size;
+		return !fclose(file) && size;
+	}
+
+	bool EmitterPreset::Reload() {
+		struct stat info;
+		std::string path;
+
+		if (_path.empty() || stat(_path.c_str(), &info) || info.st_mtime == _modified)
+			return 0;
+
+		// Load replaces _path
+		path = _path;
+		if (Load(path.c_str()) == PRESET_SUCCESS)
+			return 1;
+
+		// Keep the old settings and don't retry until the file changes again
+		_modified = info.st_mtime;
+		return 0;
+	}
+
+	//---------------------------------------------------------------------------
+	// Emitter Functions
+	//---------------------------------------------------------------------------
+	Emitter * EmitterPreset::Create(Mini * mini) const {
+		Emitter * emitter;
+
+		if (!mini)
+			return NULL;
+
+		emitter = new Emitter(mini, _settings.MaxParticles);
+		Apply(emitter);
+		return emitter;
+	}
+
+	void EmitterPreset::Apply(Emitter * emitter) const {
+		const PresetSettings * s = &_settings;
+		int i;
+
+		if (!emitter)
+			return;
+
+		// The curve setters join running jobs, so nothing below is swapped out from under them
+		emitter->SetColorCurve(s->ColorCurve.empty() ? NULL : &s->ColorCurve[0], s->ColorCurve.size());
+		emitter->SetAlphaCurve(s->AlphaCurve.empty() ? NULL : &s->AlphaCurve[0], s->AlphaCurve.size());
+		emitter->SetSizeCurve(s->SizeCurve.empty() ? NULL : &s->SizeCurve[0], s->SizeCurve.size());
+
+		for (i = 0; i < PRESET_VECTORS; i++)
+			emitter->*presetVectors[i].Field = s->Vectors[i];
+		for (i = 0; i < PRESET_FLOATS; i++)
+			emitter->*presetFloats[i].Field = s->Floats[i];
+		for (i = 0; i < PRESET_FLAGS; i++)
+			emitter->*presetFlags[i].Field = s->Flags[i];
+
+		emitter->MinParticles = s->MinParticles < 0 ? emitter->GetMaxParticles() : (unsigned int)s->MinParticles;
+		emitter->Blend = s->Blend;
+		emitter->Attractors = s->Attractors;
+
+		if (s->HasClip) {
+			emitter->Clip.Location.Set(s->Clip[0], s->Clip[1]);
+			emitter->Clip.Dimension.Set(s->Clip[2], s->Clip[3]);
+			emitter->Clip.RectangleAngle = s->Clip[4];
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Get Functions
+	//---------------------------------------------------------------------------
+	unsigned int EmitterPreset::GetMaxParticles() const {
+		return _settings.MaxParticles;
+	}
+
+	unsigned int EmitterPreset::GetVersion() const {
+		return _version;
+	}
+
+	//---------------------------------------------------------------------------
+	// Private Functions
+	//---------------------------------------------------------------------------
+	void EmitterPreset::defaults(PresetSettings * settings) {
+		int i;
+
+		settings->Vectors.resize(PRESET_VECTORS);
+		for (i = 0; i < PRESET_VECTORS; i++)
+			settings->Vectors[i].Set(presetVectors[i].Min, presetVectors[i].Max);
+		settings->Floats.resize(PRESET_FLOATS);
+		for (i = 0; i < PRESET_FLOATS; i++)
+			settings->Floats[i] = presetFloats[i].Default;
+		settings->Flags.assign(PRESET_FLAGS, false);
+
+		settings->MinParticles = -1;
+		settings->MaxParticles = 1000;
+		settings->Blend = Mini::BLEND_NORMAL;
+		settings->HasClip = 0;
+		memset(settings->Clip, 0, sizeof(settings->Clip));
+		settings->Attractors.clear();
+		settings->ColorCurve.clear();
+		settings->AlphaCurve.clear();
+		settings->SizeCurve.clear();
+	}
+
+	EmitterPreset::PresetLoadStatus EmitterPreset::parseText(const char * text, unsigned int size, PresetSettings * settings) {
+		std::vector<char> copy(text, text + size);
+		std::vector<float> values;
+		Emitter::EmitterAttractor attractor;
+		char * line, * next, * name, * args;
+		bool found;
+		int i;
+
+		copy.push_back(0);
+		for (line = &copy[0]; line; line = next) {
+			// Split off the line and drop its comment
+			next = strchr(line, '\n');
+			if (next)
+				*next++ = 0;
+			if ((args = strchr(line, '#')))
+				*args = 0;
+
+			// Name is the first word
+			while (isspace((unsigned char)*line))
+				line++;
+			if (!*line)
+				continue;
+			name = line;
+			while (*line && !isspace((unsigned char)*line))
+				line++;
+			args = line;
+			if (*line)
+				*args++ = 0;
+
+			if (!strcmp(name, "ColorCurve")) {
+				settings->ColorCurve.clear();
+				if (!readColors(args, &settings->ColorCurve))
+					return PRESET_INVALID_FORMAT;
+				continue;
+			}
+			if (!strcmp(name, "Blend")) {
+				// Exactly one word, matched whole
+				while (isspace((unsigned char)*args))
+					args++;
+				for (line = args; *line && !isspace((unsigned char)*line); line++);
+				if (*line)
+					*line++ = 0;
+				while (isspace((unsigned char)*line))
+					line++;
+				for (i = 0; i < PRESET_BLENDS; i++)
+					if (!strcmp(args, presetBlends[i]))
+						break;
+				if (i == PRESET_BLENDS || *line)
+					return PRESET_INVALID_FORMAT;
+				settings->Blend = (Mini::BlendMode)i;
+				continue;
+			}
+
+			// Everything else is numbers
+			values.clear();
+			if (!readFloats(args, &values))
+				return PRESET_INVALID_FORMAT;
+
+			found = 0;
+			for (i = 0; i < PRESET_VECTORS && !found; i++) {
+				if (!strcmp(name, presetVectors[i].Name)) {
+					if (values.size() != 2)
+						return PRESET_INVALID_FORMAT;
+					settings->Vectors[i].Set(values[0], values[1]);
+					found = 1;
+				}
+			}
+			for (i = 0; i < PRESET_FLOATS && !found; i++) {
+				if (!strcmp(name, presetFloats[i].Name)) {
+					if (values.size() != 1)
+						return PRESET_INVALID_FORMAT;
+					settings->Floats[i] = values[0];
+					found = 1;
+				}
+			}
+			for (i = 0; i < PRESET_FLAGS && !found; i++) {
+				if (!strcmp(name, presetFlags[i].Name)) {
+					if (values.size() != 1)
+						return PRESET_INVALID_FORMAT;
+					settings->Flags[i] = values[0] != 0;
+					found = 1;
+				}
+			}
+			if (found)
+				continue;
+
+			if (!strcmp(name, "MinParticles") && values.size() == 1 && values[0] >= 0 && values[0] <= EMITTER_MAX_PARTICLES)
+				settings->MinParticles = (int)values[0];
+			else if (!strcmp(name, "MaxParticles") && values.size() == 1 && values[0] >= 1)
+				settings->MaxParticles = values[0] < EMITTER_MAX_PARTICLES ? (unsigned int)values[0] : EMITTER_MAX_PARTICLES;
+			else if (!strcmp(name, "Clip") && (values.size() == 4 || values.size() == 5)) {
+				settings->HasClip = 1;
+				settings->Clip[4] = 0;
+				for (i = 0; i < (int)values.size(); i++)
+					settings->Clip[i] = values[i];
+			}
+			else if (!strcmp(name, "Attractor") && values.size() == 4) {
+				attractor.X = values[0];
+				attractor.Y = values[1];
+				attractor.Strength = values[2];
+				attractor.Radius = values[3];
+				settings->Attractors.push_back(attractor);
+			}
+			else if (!strcmp(name, "AlphaCurve"))
+				settings->AlphaCurve = values;
+			else if (!strcmp(name, "SizeCurve"))
+				settings->SizeCurve = values;
+			else
+				return PRESET_INVALID_FORMAT;
+		}
+
+		if (settings->MinParticles > (int)settings->MaxParticles)
+			return PRESET_INVALID_FORMAT;
+
+		return PRESET_SUCCESS;
+	}
+
+	EmitterPreset::PresetLoadStatus EmitterPreset::parseBinary(const unsigned char * data, unsigned int size, PresetSettings * settings) {
+		const unsigned char * end = data + size;
+		Emitter::EmitterAttractor attractor;
+		unsigned int word, count, flags;
+		float x, y;
+		int i, curve;
+
+		if (!readWord(&data, end, &word) || word != PRESET_MAGIC)
+			return PRESET_INVALID_FORMAT;
+		if (!readWord(&data, end, &word) || word != PRESET_VERSION)
+			return PRESET_INVALID_FORMAT;
+
+		for (i = 0; i < PRESET_VECTORS; i++) {
+			if (!readFloat(&data, end, &x) || !readFloat(&data, end, &y))
+				return PRESET_INVALID_FORMAT;
+			settings->Vectors[i].Set(x, y);
+		}
+		for (i = 0; i < PRESET_FLOATS; i++)
+			if (!readFloat(&data, end, &settings->Floats[i]))
+				return PRESET_INVALID_FORMAT;
+		if (!readWord(&data, end, &flags))
+			return PRESET_INVALID_FORMAT;
+		for (i = 0; i < PRESET_FLAGS; i++)
+			settings->Flags[i] = (flags >> i) & 1;
+
+		if (!readWord(&data, end, &word))
+			return PRESET_INVALID_FORMAT;
+		settings->MinParticles = (int)word;
+		if (settings->MinParticles < -1 || !readWord(&data, end, &settings->MaxParticles) || !settings->MaxParticles)
+			return PRESET_INVALID_FORMAT;
+		if (settings->MaxParticles > EMITTER_MAX_PARTICLES)
+			settings->MaxParticles = EMITTER_MAX_PARTICLES;
+		if (settings->MinParticles >= 0 && (unsigned int)settings->MinParticles > settings->MaxParticles)
+			return PRESET_INVALID_FORMAT;
+		if (!readWord(&data, end, &word) || word >= (unsigned int)PRESET_BLENDS)
+			return PRESET_INVALID_FORMAT;
+		settings->Blend = (Mini::BlendMode)word;
+
+		if (!readWord(&data, end, &word))
+			return PRESET_INVALID_FORMAT;
+		settings->HasClip = word != 0;
+		for (i = 0; i < 5; i++)
+			if (!readFloat(&data, end, &settings->Clip[i]))
+				return PRESET_INVALID_FORMAT;
+
+		// Counted arrays. Counts are checked against what is left before anything is allocated
+		if (!readWord(&data, end, &count) || count > (unsigned int)(end - data) / 16)
+			return PRESET_INVALID_FORMAT;
+		while (count--) {
+			readFloat(&data, end, &attractor.X);
+			readFloat(&data, end, &attractor.Y);
+			readFloat(&data, end, &attractor.Strength);
+			readFloat(&data, end, &attractor.Radius);
+			settings->Attractors.push_back(attractor);
+		}
+
+		for (curve = PRESET_COLOR_KEYS; curve <= PRESET_SIZE_KEYS; curve++) {
+			if (!readWord(&data, end, &count) || count > (unsigned int)(end - data) / 4)
+				return PRESET_INVALID_FORMAT;
+			while (count--) {
+				readWord(&data, end, &word);
+				memcpy(&x, &word, sizeof(x));
+				if (curve == PRESET_COLOR_KEYS)
+					settings->ColorCurve.push_back(word);
+				else if (curve == PRESET_ALPHA_KEYS)
+					settings->AlphaCurve.push_back(x);
+				else
+					settings->SizeCurve.push_back(x);
+			}
+		}
+
+		return data == end ? PRESET_SUCCESS : PRESET_INVALID_FORMAT;
+	}
+
+	void EmitterPreset::writeText(const PresetSettings * settings, std::string * out) {
+		const std::vector<float> * curves[2] = { &settings->AlphaCurve, &settings->SizeCurve };
+		const char * curveNames[2] = { "AlphaCurve", "SizeCurve" };
+		unsigned int i, c;
+
+		writeLine(out, "MaxParticles %u\n", settings->MaxParticles);
+		if (settings->MinParticles >= 0)
+			writeLine(out, "MinParticles %d\n", settings->MinParticles);
+		for (i = 0; i < (unsigned int)PRESET_VECTORS; i++)
+			writeLine(out, "%s %g %g\n", presetVectors[i].Name, settings->Vectors[i].X, settings->Vectors[i].Y);
+		for (i = 0; i < (unsigned int)PRESET_FLOATS; i++)
+			writeLine(out, "%s %g\n", presetFloats[i].Name, settings->Floats[i]);
+		for (i = 0; i < (unsigned int)PRESET_FLAGS; i++)
+			writeLine(out, "%s %d\n", presetFlags[i].Name, (int)settings->Flags[i]);
+		writeLine(out, "Blend %s\n", presetBlends[settings->Blend]);
+
+		if (settings->HasClip)
+			writeLine(out, "Clip %g %g %g %g %g\n", settings->Clip[0], settings->Clip[1], settings->Clip[2], settings->Clip[3], settings->Clip[4]);
+		for (i = 0; i < settings->Attractors.size(); i++) {
+			const Emitter::EmitterAttractor * a = &settings->Attractors[i];
+			writeLine(out, "Attractor %g %g %g %g\n", a->X, a->Y, a->Strength, a->Radius);
+		}
+
+		if (!settings->ColorCurve.empty()) {
+			out->append("ColorCurve");
+			for (i = 0; i < settings->ColorCurve.size(); i++)
+				writeLine(out, " %08X", settings->ColorCurve[i]);
+			out->append("\n");
+		}
+		for (c = 0; c < 2; c++) {
+			if (curves[c]->empty())
+				continue;
+			out->append(curveNames[c]);
+			for (i = 0; i < curves[c]->size(); i++)
+				writeLine(out, " %g", (*curves[c])[i]);
+			out->append("\n");
+		}
+	}
+
+	void EmitterPreset::writeBinary(const PresetSettings * settings, std::vector<unsigned char> * out) {
+		unsigned int flags = 0, i;
+
+		writeWord(out, PRESET_MAGIC);
+		writeWord(out, PRESET_VERSION);
+
+		for (i = 0; i < (unsigned int)PRESET_VECTORS; i++) {
+			writeFloat(out, settings->Vectors[i].X);
+			writeFloat(out, settings->Vectors[i].Y);
+		}
+		for (i = 0; i < (unsigned int)PRESET_FLOATS; i++)
+			writeFloat(out, settings->Floats[i]);
+		for (i = 0; i < (unsigned int)PRESET_FLAGS; i++)
+			flags |= (unsigned int)settings->Flags[i] << i;
+		writeWord(out, flags);
+
+		writeWord(out, (unsigned int)settings->MinParticles);
+		writeWord(out, settings->MaxParticles);
+		writeWord(out, settings->Blend);
+
+		writeWord(out, settings->HasClip);
+		for (i = 0; i < 5; i++)
+			writeFloat(out, settings->Clip[i]);
+
+		writeWord(out, settings->Attractors.size());
+		for (i = 0; i < settings->Attractors.size(); i++) {
+			writeFloat(out, settings->Attractors[i].X);
+			writeFloat(out, settings->Attractors[i].Y);
+			writeFloat(out, settings->Attractors[i].Strength);
+			writeFloat(out, settings->Attractors[i].Radius);
+		}
+
+		writeWord(out, settings->ColorCurve.size());
+		for (i = 0; i < settings->ColorCurve.size(); i++)
+			writeWord(out, settings->ColorCurve[i]);
+		writeWord(out, settings->AlphaCurve.size());
+		for (i = 0; i < settings->AlphaCurve.size(); i++)
+			writeFloat(out, settings->AlphaCurve[i]);
+		writeWord(out, settings->SizeCurve.size());
+		for (i = 0; i < settings->SizeCurve.size(); i++)
+			writeFloat(out, settings->SizeCurve[i]);
+	}
+
+	static bool readFloats(const char * text, std::vector<float> * values) {
+		char * end;
+		float value;
+
+		while (1) {
+			while (isspace((unsigned char)*text))
+				text++;
+			if (!*text)
+				return 1;
+
+			value = (float)strtod(text, &end);
+			if (end == text || (*end && !isspace((unsigned char)*end)) || !isfinite(value))
+				return 0;
+			values->push_back(value);
+			text = end;
+		}
+	}
+
+	static bool readColors(const char * text, std::vector<unsigned int> * colors) {
+		unsigned int color;
+		char * end;
+
+		while (1) {
+			while (isspace((unsigned char)*text))
+				text++;
+			if (!*text)
+				return !colors->empty();
+
+			color = (unsigned int)strtoul(text, &end, 16);
+			if (end == text || (*end && !isspace((unsigned char)*end)))
+				return 0;
+			colors->push_back(color);
+			text = end;
+		}
+	}
+
+	static bool readWord(const unsigned char ** data, const unsigned char * end, unsigned int * value) {
+		const unsigned char * d = *data;
+
+		if (end - d < 4)
+			return 0;
+		*value = (d[0] << 24) | (d[1] << 16) | (d[2] << 8) | d[3];
+		*data = d + 4;
+		return 1;
+	}
+
+	static bool readFloat(const unsigned char ** data, const unsigned char * end, float * value) {
+		unsigned int word;
+
+		if (!readWord(data, end, &word))
+			return 0;
+		memcpy(value, &word, sizeof(word));
+		return isfinite(*value);
+	}
+
+	static void writeWord(std::vector<unsigned char> * out, unsigned int value) {
+		out->push_back(value >> 24);
+		out->push_back(value >> 16);
+		out->push_back(value >> 8);
+		out->push_back(value);
+	}
+
+	static void writeFloat(std::vector<unsigned char> * out, float value) {
+		unsigned int word;
+
+		memcpy(&word, &value, sizeof(word));
+		writeWord(out, word);
+	}
+
+	static void writeLine(std::string * out, const char * format, ...) {
+		char line[256];
+		va_list args;
+
+		va_start(args, format);
+		vsnprintf(line, sizeof(line), format, args);
+		va_end(args);
+		out->append(line);
+	}
+}
@@ -7,6 +7,9 @@
 
 #include <freetype/ftglyph.h>                    // For loading TTF character and converting to raw RGBA
 #include <wchar.h>                               // wcslen(), wprintf()
+#include <string.h>                              // memset
+
+#include <algorithm>                             // std::lower_bound
 
 #include <tiny3d.h>                              // Tiny3D functions
 #include <Mini2D/Font.hpp>                       // Class definition
@@ -19,6 +22,10 @@ namespace Mini2D {
 	Font::Font(Mini * mini) :
 			_mini(mini) {
 
+		memset(_table, 0, sizeof(_table));
+		memset(_advance, 0, sizeof(_advance));
+		memset(_present, 0, sizeof(_present));
+
 		if (!mini)
 			return;
 
@@ -42,6 +49,11 @@ namespace Mini2D {
 	void Font::unloadCharMap() {
 		for(std::vector<FontChar*>::iterator it = CharMap.begin(); it != CharMap.end(); it++) { if (*it) {delete *it;} }
 		CharMap.clear();
+
+		memset(_table, 0, sizeof(_table));
+		memset(_advance, 0, sizeof(_advance));
+		memset(_present, 0, sizeof(_present));
+		_kerning.clear();
 	}
 
 	//---------------------------------------------------------------------------
@@ -109,11 +121,12 @@ namespace Mini2D {
 	}
 
 	int Font::printLine(const std::wstring& string, int * startIndex, const Vector2& location, float size, bool useContainer, bool draw) {
-		int j,len;
-		float cRight=0,cLeft=0,cTop=0,cBottom=0,w;
+		int j,k;
+		float cRight=0,cLeft=0,cTop=0,cBottom=0,w,x;
 		float cw = 0, ch = 0;
 		bool wrap = 0;
 		FontChar * fc = NULL;
+		FontLine line;
 		Vector2 loc = location;
 
 		if (!_mini || string.empty() || !ForeColor)
@@ -130,9 +143,13 @@ namespace Mini2D {
 		// Start index
 		j = (startIndex?(*startIndex):0);
 
+		// Measure once, keeping where each glyph goes
+		line = measureLine(string, size, j, 0, NULL, 1);
+		j = line.Next;
+
 		// Align X
 		// If useContainer: only align if the string width is less than the container width
-		w = GetWidth(string,size,j);
+		w = line.Width;
 		if (w < (useContainer?Container.Dimension.X:w+1)) {
 			switch (TextAlign) {
 				case PRINT_ALIGN_TOPCENTER:
@@ -168,30 +185,22 @@ namespace Mini2D {
 				break;
 		}
 
-		len = string.length();
-		for (; j < len; j++) {
-			if (isNewline(string, len, &j)) {
-				j++;
+		for (k = 0; k < (int)_glyphs.size(); k++) {
+			fc = _glyphs[k].Char;
+			x = loc.X + _glyphs[k].X;
+			cw = getDimension(fc->w, fc->fr, size);
+			ch = getDimension(fc->h, fc->fr, size);
+
+			// If we are drawing past the container, stop
+			if (useContainer && (x + cw) > cRight) {
+				wrap = 1;
+				j = _glyphs[k].Index;
 				break;
 			}
 
-			fc = getFontChar(string.at(j));
-			if (fc) {
-				cw = getDimension(fc->w, fc->fr, size);
-				ch = getDimension(fc->h, fc->fr, size);
-
-				// If we are drawing past the container, stop
-				if (useContainer && (loc.X + cw) > cRight) {
-					wrap = 1;
-					break;
-				}
-
-				// If draw is false or we are drawing before the container, skip
-				if (!draw || (useContainer && (loc.X < cLeft || loc.Y+ch > cBottom || loc.Y < cTop)))
-					loc.X += cw + SpacingOffset;
-				else
-					loc.X += printChar(fc, loc.X, loc.Y, size);
-			}
+			// If draw is false or we are drawing before the container, skip
+			if (draw && !(useContainer && (x < cLeft || loc.Y+ch > cBottom || loc.Y < cTop)))
+				printChar(fc, x, loc.Y, size);
 		}
 
 		if (startIndex)
@@ -241,31 +250,142 @@ namespace Mini2D {
 	}
 
 	float Font::GetWidth(const std::wstring& string, float size, int offset) {
-		int i,l;
-		float width = 0.f;
-
 		if (string.empty())
 			return 0.f;
 
+		return measureLine(string, size, offset, 0, NULL, 0).Width;
+	}
+
+	float Font::GetWidth(wchar_t chr, float size) {
+		FontChar * fc;
+
+		if (chr >= 0 && chr < FONT_TABLE_SIZE)
+			return _present[chr] ? _advance[chr] * size + SpacingOffset : 0;
+
+		fc = getFontChar(chr);
+		return fc ? getDimension(fc->fw, fc->fr, size) + SpacingOffset : 0;
+	}
+
+	float Font::GetKerning(wchar_t left, wchar_t right, float size) {
+		u32 pair, mask, i;
+
+		if (_kerning.empty() || left < 0 || left >= FONT_TABLE_SIZE || right < 0 || right >= FONT_TABLE_SIZE)
+			return 0;
+
+		pair = ((u32)left << 8) | (u32)right;
+		mask = _kerning.size() - 1;
+		for (i = kerningSlot(pair, mask); _kerning[i].Pair != FONT_KERNING_EMPTY; i = (i + 1) & mask)
+			if (_kerning[i].Pair == pair)
+				return _kerning[i].Offset * size;
+
+		return 0;
+	}
+
+	Font::FontLine Font::MeasureLine(const std::wstring& string, float size, int offset, float maxWidth, std::vector<float> * positions) {
+		return measureLine(string, size, offset, maxWidth, positions, 0);
+	}
+
+	int Font::MeasureLines(const std::wstring& string, float size, float maxWidth, std::vector<FontLine> * lines) {
+		int i = 0, len = string.length(), count = 0;
+		FontLine line;
+
+		if (!lines)
+			return 0;
+
+		while (i < len) {
+			line = measureLine(string, size, i, maxWidth, NULL, 0);
+			lines->push_back(line);
+			count++;
+			i = line.Next;
+		}
+
+		return count;
+	}
+
+	Font::FontLine Font::measureLine(const std::wstring& string, float size, int offset, float maxWidth, std::vector<float> * positions, bool glyphs) {
+		const wchar_t * chars = string.data();
+		int j, k, end, len = string.length();
+		float x = 0, advance, kerning, sums[4] = { 0, 0, 0, 0 }, counts[4] = { 0, 0, 0, 0 };
+		wchar_t chr, previous = 0;
+		FontGlyph glyph;
+		FontChar * fc;
+		FontLine line;
+
 		if (offset < 0)
 			offset = 0;
+		if (glyphs)
+			_glyphs.clear();
+
+		line.Start = offset;
+		line.Wrapped = 0;
+		j = offset;
+
+		// Without kerning, wrapping, or positions to record, long runs of table characters are summed four
+		// at a time into independent lanes, so each add doesn't wait on the one before it
+		if (!positions && !glyphs && maxWidth <= 0 && _kerning.empty()) {
+			for (; j + 4 <= len; j += 4) {
+				for (k = 0; k < 4; k++) {
+					chr = chars[j+k];
+					if (chr < 0 || chr >= FONT_TABLE_SIZE || (chr >= 0x000A && chr <= 0x000D) || chr == 0x0085)
+						break;
+				}
+				if (k < 4)
+					break;
 
-		l = string.length();
-		for (i=offset;i<l;i++) {
-			if (isNewline(string, l, &i))
-				break;
-			width += GetWidth(string.at(i), size);
+				for (k = 0; k < 4; k++) {
+					sums[k] += _advance[chars[j+k]];
+					counts[k] += _present[chars[j+k]];
+				}
+			}
+			x = (sums[0] + sums[1] + sums[2] + sums[3]) * size + (counts[0] + counts[1] + counts[2] + counts[3]) * SpacingOffset;
 		}
 
-		return width;
-	}
+		for (; j < len; j++) {
+			end = j;
+			if (isNewline(string, len, &j)) {
+				line.End = end;
+				line.Next = j + 1;
+				line.Width = x;
+				return line;
+			}
 
-	float Font::GetWidth(wchar_t chr, float size) {
-		for(std::vector<FontChar*>::iterator it = CharMap.begin(); it != CharMap.end(); it++)
-			if ((*it)->chr == chr)
-				return getDimension((*it)->fw, (*it)->fr, size) + SpacingOffset;
+			chr = chars[j];
+			fc = getFontChar(chr);
+			if (!fc) {
+				if (positions)
+					positions->push_back(x);
+				previous = 0;
+				continue;
+			}
 
-		return 0;
+			kerning = previous ? GetKerning(previous, chr, size) : 0;
+			advance = getDimension(fc->fw, fc->fr, size);
+
+			// Wrap before the character that reaches past maxWidth, keeping at least one per line
+			if (maxWidth > 0 && j > offset && x + kerning + advance > maxWidth) {
+				line.End = line.Next = j;
+				line.Wrapped = 1;
+				line.Width = x;
+				return line;
+			}
+
+			x += kerning;
+			if (positions)
+				positions->push_back(x);
+			if (glyphs) {
+				glyph.Char = fc;
+				glyph.Index = j;
+				glyph.X = x;
+				_glyphs.push_back(glyph);
+			}
+
+			x += advance + SpacingOffset;
+			previous = chr;
+		}
+
+		line.End = line.Next = len > offset ? len : offset;
+		line.Width = x;
+		return line;
 	}
 
 	float Font::getDimension(float d, float r, float s) {
@@ -290,11 +410,24 @@ namespace Mini2D {
 	}
 
 	Font::FontChar * Font::getFontChar(wchar_t chr) {
-		for(std::vector<FontChar*>::iterator it = CharMap.begin(); it != CharMap.end(); it++)
-			if ((*it)->chr == chr)
-				return *it;
+		std::vector<FontChar*>::iterator it;
+
+		if (chr >= 0 && chr < FONT_TABLE_SIZE)
+			return _table[chr];
+
+		it = std::lower_bound(CharMap.begin(), CharMap.end(), chr, charLess);
+		return (it != CharMap.end() && (*it)->chr == chr) ? *it : NULL;
+	}
+
+	void Font::mapChar(FontChar * fontChar) {
+		wchar_t chr = fontChar->chr;
+
+		if (chr < 0 || chr >= FONT_TABLE_SIZE)
+			return;
 
-		return NULL;
+		_table[chr] = fontChar;
+		_advance[chr] = fontChar->fr ? (float)fontChar->fw / fontChar->fr : 0;
+		_present[chr] = 1;
 	}
 
 	//---------------------------------------------------------------------------
@@ -315,18 +448,18 @@ namespace Mini2D {
 		fontChar->fw = fontChar->w + 2;
 		fontChar->fy = yCorrection;
 		fontChar->rsx = tiny3d_TextureOffset(image->TexturePointer);
-		fontChar->format = TINY3D_TEX_FORMAT_A8R8G8B8;
+		fontChar->format = Pixel::GetTiny3DFormat(image->GetFormat());
 
-		// If this wchar is already mapped let's remove it
-		for(std::vector<FontChar*>::iterator it = CharMap.begin(); it != CharMap.end(); it++) {
-			if ((*it)->chr == chr) {
-				delete *it;
-				CharMap.erase(it);
-				break;
-			}
+		// If this wchar is already mapped let's replace it, otherwise insert it in order
+		std::vector<FontChar*>::iterator it = std::lower_bound(CharMap.begin(), CharMap.end(), chr, charLess);
+		if (it != CharMap.end() && (*it)->chr == chr) {
+			delete *it;
+			*it = fontChar;
 		}
+		else
+			CharMap.insert(it, fontChar);
 
-		CharMap.push_back(fontChar);
+		mapChar(fontChar);
 
 		return true;
 	}
@@ -421,13 +554,17 @@ namespace Mini2D {
 				texture += fontChar->p * fontChar->h;
 			}
 
+			// Unicode charmaps walk in order, so CharMap stays sorted
 			CharMap.push_back(fontChar);
+			mapChar(fontChar);
 			chr = FT_Get_Next_Char(face, chr, &index);
 		}
 
 		// Realign
 		texture = (u8 *) ((((long) texture) + 15) & ~15);
 
+		loadKerning(face);
+
 		return texture;
 	}
 
@@ -479,4 +616,55 @@ namespace Mini2D {
 		return 0;
 	}
 
+	void Font::loadKerning(FT_Face face) {
+		std::vector<FontKerning> pairs;
+		FT_UInt glyphs[FONT_TABLE_SIZE];
+		FontKerning kerning;
+		FT_Vector delta;
+		u32 l, r, i, mask, size;
+
+		_kerning.clear();
+		if (!FT_HAS_KERNING(face) || !face->units_per_EM)
+			return;
+
+		for (l = 0; l < FONT_TABLE_SIZE; l++)
+			glyphs[l] = _table[l] ? FT_Get_Char_Index(face, l) : 0;
+
+		// Unscaled offsets divided by the em size scale with the print size, like the advances
+		for (l = 0; l < FONT_TABLE_SIZE; l++) {
+			if (!glyphs[l])
+				continue;
+			for (r = 0; r < FONT_TABLE_SIZE; r++) {
+				if (!glyphs[r] || FT_Get_Kerning(face, glyphs[l], glyphs[r], FT_KERNING_UNSCALED, &delta) || !delta.x)
+					continue;
+				kerning.Pair = (l << 8) | r;
+				kerning.Offset = (float)delta.x / face->units_per_EM;
+				pairs.push_back(kerning);
+			}
+		}
+
+		if (pairs.empty())
+			return;
+
+		// At most half full keeps probes short
+		for (size = 16; size < pairs.size() * 2; size <<= 1);
+		kerning.Pair = FONT_KERNING_EMPTY;
+		kerning.Offset = 0;
+		_kerning.assign(size, kerning);
+
+		mask = size - 1;
+		for (l = 0; l < pairs.size(); l++) {
+			for (i = kerningSlot(pairs[l].Pair, mask); _kerning[i].Pair != FONT_KERNING_EMPTY; i = (i + 1) & mask);
+			_kerning[i] = pairs[l];
+		}
+	}
+
+	u32 Font::kerningSlot(u32 pair, u32 mask) {
+		return ((pair * 2654435761u) >> 8) & mask;
+	}
+
+	bool Font::charLess(const FontChar * fontChar, wchar_t chr) {
+		return fontChar->chr < chr;
+	}
+
 }
@@ -8,16 +8,36 @@
 #include <sysmodule/sysmodule.h>                 // Load and unload PNG,JPG modules
 #include <string.h>                              // memcpy, memset
 #include <math.h>                                // Trig functions
+#include <malloc.h>                              // memalign
+#include <stdio.h>                               // fopen
 
 #include <tiny3d.h>                              // Tiny3D functions
 #include <Mini2D/Image.hpp>                      // Class definition
+#include <Mini2D/Decoder.hpp>                    // Portable PNG/JPG decoder
+#include <Mini2D/JobSystem.hpp>                  // Parallel pixel conversion
 
 #define PI 3.14159265
 #define DEG2RAD(x) ((x*PI)/180.0)
 #define RAD2DEG(x) ((x*180.0)/PI)
 
+#define BAND_ROWS 32                             // Rows per pixel job (a multiple of the 4 row DXT blocks)
+
 namespace Mini2D {
 
+	typedef struct _pixelBands_t {
+		const unsigned int * ARGB;
+		int Width, Height, Pitch;
+		Pixel::PixelFormat Format;
+		unsigned char * Out;
+		volatile bool Failed;
+	} PixelBands;
+
+	// Job that runs Pixel::Convert on bands of rows start to end
+	static void convertBands(void * data, int start, int end);
+
+	// Job that runs Pixel::Premultiply on bands of rows start to end
+	static void premultiplyBands(void * data, int start, int end);
+
 	//---------------------------------------------------------------------------
 	// Init Functions
 	//---------------------------------------------------------------------------
@@ -37,27 +57,73 @@ namespace Mini2D {
 		_sWidth = 0;
 		_sHeight = 0;
 		_textureOff = 0;
+		_cached = NULL;
+		memset(&_texture, 0, sizeof(TextureCache::Texture));
+		_texture.Format = Pixel::PIXEL_FORMAT_A8R8G8B8;
+
+		Mipmaps = 0;
+		MipBias = 0;
 	}
 
 	Image::~Image() {
+		release();
 		_mini = NULL;
 		_textureOff = 0;
 	}
 
 	void Image::loadModules() {
+#ifndef MINI2D_PORTABLE_DECODER
 		if (sysModuleIsLoaded(SYSMODULE_PNGDEC))
 			sysModuleLoad(SYSMODULE_PNGDEC);
 		if (sysModuleIsLoaded(SYSMODULE_JPGDEC))
 			sysModuleLoad(SYSMODULE_JPGDEC);
+#endif
+	}
+
+	void Image::release() {
+		TextureCache::Release(_cached);
+		_cached = NULL;
+	}
+
+	//---------------------------------------------------------------------------
+	// Cache Functions
+	//---------------------------------------------------------------------------
+	unsigned long long Image::cacheKey(unsigned long long source, Pixel::PixelFormat format) {
+		unsigned int settings[3];
+
+		settings[0] = (unsigned int)format;
+		settings[1] = Mipmaps ? 1 : 0;
+		settings[2] = _mini->GetPremultipliedAlpha() ? 1 : 0;
+		return TextureCache::Hash(settings, sizeof(settings), source);
+	}
+
+	bool Image::acquire(unsigned long long key) {
+		TextureCache::CacheEntry * entry = _mini->GetTextureCache()->Acquire(key);
+
+		if (!entry)
+			return 0;
+
+		_cached = entry;
+		_texture = entry->Data;
+		useTexture();
+		return 1;
 	}
 
 	//---------------------------------------------------------------------------
 	// Load Functions
 	//---------------------------------------------------------------------------
-	Image::ImageLoadStatus Image::Load(char * filepath) {
+	Image::ImageLoadStatus Image::Load(char * filepath, Pixel::PixelFormat format) {
 		int len, type;
+		unsigned long long key;
+#ifdef MINI2D_PORTABLE_DECODER
+		ImageLoadStatus status;
+		unsigned char * data;
+		FILE * file;
+		long size;
+#else
 		pngData png;
 		jpgData jpg;
+#endif
 
 		if (_mini == NULL)
 			return IMAGE_INVALID_MINI2D;
@@ -98,39 +164,98 @@ namespace Mini2D {
 		return IMAGE_INVALID_ARG;
 
 		process: ;
+		release();
+		key = cacheKey(TextureCache::Hash(filepath, len), format);
+		if (acquire(key))
+			goto end;
+
+#ifdef MINI2D_PORTABLE_DECODER
+		file = fopen(filepath, "rb");
+		if (!file)
+			return IMAGE_INVALID_ARG;
+		fseek(file, 0, SEEK_END);
+		size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		if (size <= 0) {
+			fclose(file);
+			return IMAGE_INVALID_ARG;
+		}
+
+		data = (unsigned char*)malloc(size);
+		if (!data || fread(data, 1, size, file) != (size_t)size) {
+			fclose(file);
+			if (data)
+				free(data);
+			return data ? IMAGE_INVALID_ARG : IMAGE_NO_MEM;
+		}
+		fclose(file);
+
+		status = decode(data, size, type ? IMAGE_TYPE_PNG : IMAGE_TYPE_JPG, format, key);
+		free(data);
+		if (status != IMAGE_SUCCESS)
+			return status;
+#else
 		if (type) {
 			if (pngLoadFromFile(filepath, &png))
 				return IMAGE_INVALID_ARG;
-			toRSX((void*)&png);
+			toRSX((void*)&png, format, key);
 		}
 		else {
 			if (jpgLoadFromFile(filepath, &jpg))
 				return IMAGE_INVALID_ARG;
-			toRSX((void*)&jpg);
+			toRSX((void*)&jpg, format, key);
 		}
+#endif
+
+		end: ;
+		if (!_textureOff)
+			return IMAGE_NO_MEM;
+
+		_sWidth = (float)_width / (float)Video_Resolution.width;
+		_sHeight = (float)_height / (float)Video_Resolution.height;
 
 		return IMAGE_SUCCESS;
 	}
 
-	Image::ImageLoadStatus Image::Load(void * buffer, unsigned int size, ImageType type) {
+	Image::ImageLoadStatus Image::Load(void * buffer, unsigned int size, ImageType type, Pixel::PixelFormat format) {
+		unsigned long long key;
+#ifdef MINI2D_PORTABLE_DECODER
+		ImageLoadStatus status;
+#else
 		pngData png;
 		jpgData jpg;
+#endif
 
 		if (_mini == NULL)
 			return IMAGE_INVALID_MINI2D;
+		if (!buffer || !size)
+			return IMAGE_INVALID_ARG;
+
+		release();
+		key = cacheKey(TextureCache::Hash(buffer, size), format);
+		if (acquire(key))
+			goto end;
 
+#ifdef MINI2D_PORTABLE_DECODER
+		status = decode(buffer, size, type, format, key);
+		if (status != IMAGE_SUCCESS)
+			return status;
+#else
 		switch (type) {
 			case IMAGE_TYPE_PNG:
 				if (pngLoadFromBuffer(buffer, size, &png))
 					return IMAGE_INVALID_ARG;
-				toRSX((void*)&png);
+				toRSX((void*)&png, format, key);
 				break;
 			case IMAGE_TYPE_JPG:
 				if (jpgLoadFromBuffer(buffer, size, &jpg))
 					return IMAGE_INVALID_ARG;
-				toRSX((void*)&jpg);
+				toRSX((void*)&jpg, format, key);
 				break;
 		}
+#endif
+
+		end: ;
 		if (!_textureOff)
 			return IMAGE_NO_MEM;
 
@@ -140,50 +265,453 @@ namespace Mini2D {
 		return IMAGE_SUCCESS;
 	}
 
-	void Image::Load(void * argbBuffer, int w, int h) {
-		_textureOff = _mini->AddTexture(argbBuffer, w * 4, h);
-
-		_pitch = w * 4;
-		_width = w;
-		_height = h;
+	void Image::Load(void * argbBuffer, int w, int h, Pixel::PixelFormat format) {
+		// Raw pixels are not cached and stay in the texture heap until it is reset
+		release();
+		upload((const unsigned int*)argbBuffer, w, h, w * 4, format, _mini->GetPremultipliedAlpha());
 
 		_sWidth = (float)w / (float)Video_Resolution.width;
 		_sHeight = (float)h / (float)Video_Resolution.height;
 	}
 
-	void Image::toRSX(void * buffer) {
+#ifndef MINI2D_PORTABLE_DECODER
+	void Image::toRSX(void * buffer, Pixel::PixelFormat format, unsigned long long key) {
 		jpgData img = *(jpgData*)buffer;
-		TexturePointer = _mini->TexturePointer;
-		_textureOff = _mini->AddTexture(img.bmp_out, img.pitch, img.height);
+
+		// The decoded pixels are ours so premultiply them in place
+		if (img.bmp_out && _mini->GetPremultipliedAlpha())
+			premultiplyPixels((unsigned int*)img.bmp_out, img.width, img.height, img.pitch);
+		upload((const unsigned int*)img.bmp_out, img.width, img.height, img.pitch, format, 0);
 		free(img.bmp_out);
 
-		_pitch = img.pitch;
-		_width = img.width;
-		_height = img.height;
+		if (_textureOff)
+			_cached = _mini->GetTextureCache()->Insert(key, _texture);
+	}
+#else
+	Image::ImageLoadStatus Image::decode(const void * buffer, unsigned int size, ImageType type, Pixel::PixelFormat format, unsigned long long key) {
+		Decoder::DecoderType decoderType = type == IMAGE_TYPE_JPG ? Decoder::DECODER_TYPE_JPG : Decoder::DECODER_TYPE_PNG;
+		unsigned int * argb;
+		int w, h, pitch;
+
+		if (!Decoder::GetSize(buffer, size, decoderType, &w, &h))
+			return IMAGE_INVALID_ARG;
+
+		_textureOff = 0;
+		if (format == Pixel::PIXEL_FORMAT_A8R8G8B8 && !Mipmaps) {
+			// Already the texture's layout so decode straight into the texture heap
+			if (!reserve(w, h, format))
+				return IMAGE_NO_MEM;
+			if (!Decoder::Decode(buffer, size, decoderType, (unsigned int*)_texture.Pointer, _texture.Mips[0].Pitch, _mini->GetPremultipliedAlpha())) {
+				_mini->FreeTexture(_texture.Pointer, _texture.Size);
+				memset(&_texture, 0, sizeof(TextureCache::Texture));
+				return IMAGE_INVALID_ARG;
+			}
+			useTexture();
+		}
+		else {
+			// Other formats and mip levels are made from an ARGB copy
+			pitch = (w * 4 + 15) & ~15;
+			argb = (unsigned int*)memalign(16, pitch * h);
+			if (!argb)
+				return IMAGE_NO_MEM;
+			if (!Decoder::Decode(buffer, size, decoderType, argb, pitch, _mini->GetPremultipliedAlpha())) {
+				free(argb);
+				return IMAGE_INVALID_ARG;
+			}
+			upload(argb, w, h, pitch, format, 0);
+			free(argb);
+		}
+
+		if (!_textureOff)
+			return IMAGE_NO_MEM;
+
+		_cached = _mini->GetTextureCache()->Insert(key, _texture);
+		return IMAGE_SUCCESS;
+	}
+#endif
+
+	bool Image::reserve(int w, int h, Pixel::PixelFormat format) {
+		unsigned int sizes[TEXTURE_MAX_MIPS], size = 0;
+		unsigned char * texture;
+		int level, count;
+
+		memset(&_texture, 0, sizeof(TextureCache::Texture));
+
+		// Size every level up front so the whole chain is one allocation
+		count = Mipmaps ? TEXTURE_MAX_MIPS : 1;
+		for (level = 0; level < count; level++) {
+			_texture.Mips[level].Width = w;
+			_texture.Mips[level].Height = h;
+			_texture.Mips[level].Pitch = Pixel::GetPitch(format, w);
+			sizes[level] = (_texture.Mips[level].Pitch * Pixel::GetRows(format, h) + 15) & ~15;
+			size += sizes[level];
+
+			if (w <= 1 && h <= 1) {
+				level++;
+				break;
+			}
+			w = w > 1 ? w / 2 : 1;
+			h = h > 1 ? h / 2 : 1;
+		}
+		count = level;
+
+		// Fall back to the full size level alone if the chain does not fit
+		texture = (unsigned char*)_mini->AllocTexture(size, NULL);
+		if (!texture && count > 1) {
+			count = 1;
+			size = sizes[0];
+			texture = (unsigned char*)_mini->AllocTexture(size, NULL);
+		}
+		if (!texture)
+			return 0;
+
+		_texture.Format = format;
+		_texture.MipCount = count;
+		_texture.Pointer = texture;
+		_texture.Size = size;
+		for (level = 0; level < count; level++) {
+			_texture.Mips[level].TextureOff = tiny3d_TextureOffset(texture);
+			texture += sizes[level];
+		}
+
+		return 1;
+	}
+
+	void Image::upload(const unsigned int * argb, int w, int h, int pitch, Pixel::PixelFormat format, bool premultiply) {
+		unsigned int * copy = NULL;
+		int y, copyPitch = (w * 4 + 15) & ~15;
+
+		_textureOff = 0;
+		if (!argb)
+			return;
+
+		if (format == Pixel::PIXEL_FORMAT_AUTO)
+			format = Pixel::ChooseFormat(argb, w, h, pitch);
+
+		// Opaque images are unchanged by premultiplying
+		if (premultiply && Pixel::GetAlphaType(argb, w, h, pitch) != Pixel::PIXEL_ALPHA_OPAQUE) {
+			copy = (unsigned int*)memalign(16, copyPitch * h);
+			if (!copy)
+				return;
+			for (y = 0; y < h; y++)
+				memcpy((unsigned char*)copy + y * copyPitch, (const unsigned char*)argb + y * pitch, w * 4);
+			pitch = copyPitch;
+			premultiplyPixels(copy, w, h, pitch);
+			argb = copy;
+		}
+
+		// Convert straight into the texture heap
+		if (!reserve(w, h, format))
+			goto end;
+		if (!convertPixels(argb, w, h, pitch, format, _texture.Pointer)) {
+			_mini->FreeTexture(_texture.Pointer, _texture.Size);
+			memset(&_texture, 0, sizeof(TextureCache::Texture));
+			goto end;
+		}
+
+		if (_texture.MipCount > 1)
+			uploadMips(argb, w, h, pitch);
+		useTexture();
+
+		end: ;
+		if (copy)
+			free(copy);
+	}
+
+	void Image::uploadMips(const unsigned int * argb, int w, int h, int pitch) {
+		unsigned int * buffers[2];
+		const unsigned int * src = argb;
+		unsigned char * texture = (unsigned char*)_texture.Pointer;
+		int level, nw, nh, np;
+
+		// Level 1 is the largest downsampled level so both buffers fit every level
+		nw = _texture.Mips[1].Width;
+		nh = _texture.Mips[1].Height;
+		np = (nw * 4 + 15) & ~15;
+		buffers[0] = (unsigned int*)memalign(16, np * nh);
+		buffers[1] = (unsigned int*)memalign(16, np * nh);
+		if (!buffers[0] || !buffers[1]) {
+			_texture.MipCount = 1;
+			goto end;
+		}
+
+		for (level = 1; level < _texture.MipCount; level++) {
+			unsigned int * dst = buffers[level & 1];
+
+			texture += (_texture.Mips[level-1].Pitch * Pixel::GetRows(_texture.Format, _texture.Mips[level-1].Height) + 15) & ~15;
+			nw = _texture.Mips[level].Width;
+			nh = _texture.Mips[level].Height;
+			np = (nw * 4 + 15) & ~15;
+			Pixel::Downsample(src, w, h, pitch, dst, np);
+			convertPixels(dst, nw, nh, np, _texture.Format, texture);
+
+			src = dst;
+			w = nw;
+			h = nh;
+			pitch = np;
+		}
+
+		end: ;
+		if (buffers[0])
+			free(buffers[0]);
+		if (buffers[1])
+			free(buffers[1]);
+	}
+
+	bool Image::convertPixels(const unsigned int * argb, int w, int h, int pitch, Pixel::PixelFormat format, void * out) {
+		JobSystem * jobs = _mini->GetJobSystem();
+		PixelBands bands = { argb, w, h, pitch, format, (unsigned char*)out, 0 };
+
+		if (!jobs || h <= BAND_ROWS)
+			return Pixel::Convert(argb, w, h, pitch, format, out);
+
+		jobs->ParallelFor(convertBands, &bands, (h + BAND_ROWS - 1) / BAND_ROWS, 1);
+		return !bands.Failed;
+	}
+
+	void Image::premultiplyPixels(unsigned int * argb, int w, int h, int pitch) {
+		JobSystem * jobs = _mini->GetJobSystem();
+		PixelBands bands = { argb, w, h, pitch, Pixel::PIXEL_FORMAT_A8R8G8B8, NULL, 0 };
+
+		if (!jobs || h <= BAND_ROWS) {
+			Pixel::Premultiply(argb, w, h, pitch);
+			return;
+		}
+
+		jobs->ParallelFor(premultiplyBands, &bands, (h + BAND_ROWS - 1) / BAND_ROWS, 1);
+	}
+
+	void Image::useTexture() {
+		TexturePointer = (unsigned int*)_texture.Pointer;
+		_textureOff = _texture.MipCount ? _texture.Mips[0].TextureOff : 0;
+		_width = _texture.Mips[0].Width;
+		_height = _texture.Mips[0].Height;
+		_pitch = _texture.Mips[0].Pitch;
+	}
+
+	int Image::selectMip(float texW, float texH, float w, float h) {
+		float scale = _mini->GetDrawScale(), ratio, level;
+
+		if (_texture.MipCount <= 1)
+			return 0;
+
+		// Texels per screen pixel along the most minified axis
+		w = fabs(w * scale);
+		h = fabs(h * scale);
+		if (w <= 0 || h <= 0)
+			return _texture.MipCount - 1;
+		ratio = fmax(texW / w, texH / h);
+		if (ratio <= 1 && MipBias <= 0)
+			return 0;
+
+		level = floorf(logf(ratio) / M_LN2 + MipBias);
+		if (level < 0)
+			return 0;
+		if (level >= _texture.MipCount)
+			return _texture.MipCount - 1;
+		return (int)level;
 	}
 
 	//---------------------------------------------------------------------------
 	// Draw Functions
 	//---------------------------------------------------------------------------
 	void Image::Draw(unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL) {
+		draw(&DrawRegion, ZIndex, 0.0f, 0.0f, 0.999999f, 0.999999f, rgbaTL, rgbaTR, rgbaBR, rgbaBL);
+	}
+
+	void Image::Draw(unsigned int rgba) {
+		Draw(rgba, rgba, rgba, rgba);
+	}
+
+	void Image::DrawPart(RectangleF * region, float z, float srcX, float srcY, float srcW, float srcH, unsigned int rgba) {
+		if (!region || _width <= 0 || _height <= 0)
+			return;
+
+		draw(region, z, srcX / _width, srcY / _height, (srcX + srcW) / _width, (srcY + srcH) / _height, rgba, rgba, rgba, rgba);
+	}
+
+	void Image::DrawNineSlice(RectangleF * region, float z, float left, float top, float right, float bottom, unsigned int rgba) {
+		float xs[4], ys[4], us[4], vs[4], scale, * x, * y, * u, * v;
+		int i, j, count = 0;
+
+		if (!region || _mini == NULL || !_textureOff || _width <= 0 || _height <= 0)
+			return;
+
+		float w = region->W(), h = region->H();
+		float nx = region->X(), ny = region->Y();
+		if (region->UseAnchor) {
+			Vector2 * pos = region->GetRotatedCenter();
+			nx = pos->X;
+			ny = pos->Y;
+		}
+		float x0 = nx - w / 2, y0 = ny - h / 2;
+
+		// Shrink borders that don't fit, keeping their proportions
+		scale = 1;
+		if (left + right > fabs(w))
+			scale = fabs(w) / (left + right);
+		if (top + bottom > fabs(h) && fabs(h) / (top + bottom) < scale)
+			scale = fabs(h) / (top + bottom);
+
+		xs[0] = x0; xs[1] = x0 + left * scale; xs[2] = x0 + w - right * scale; xs[3] = x0 + w;
+		ys[0] = y0; ys[1] = y0 + top * scale; ys[2] = y0 + h - bottom * scale; ys[3] = y0 + h;
+		us[0] = 0; us[1] = left / _width; us[2] = 1 - right / _width; us[3] = 0.999999f;
+		vs[0] = 0; vs[1] = top / _height; vs[2] = 1 - bottom / _height; vs[3] = 0.999999f;
+
+		reserveQuads(9);
+		x = &_quads[0]; y = x + 36; u = y + 36; v = u + 36;
+
+		// Empty parts (zero size borders) are skipped
+		for (j = 0; j < 3; j++) {
+			if (ys[j + 1] == ys[j])
+				continue;
+			for (i = 0; i < 3; i++) {
+				if (xs[i + 1] == xs[i])
+					continue;
+
+				x[0] = xs[i];     y[0] = ys[j];     u[0] = us[i];     v[0] = vs[j];
+				x[1] = xs[i + 1]; y[1] = ys[j];     u[1] = us[i + 1]; v[1] = vs[j];
+				x[2] = xs[i + 1]; y[2] = ys[j + 1]; u[2] = us[i + 1]; v[2] = vs[j + 1];
+				x[3] = xs[i];     y[3] = ys[j + 1]; u[3] = us[i];     v[3] = vs[j + 1];
+				x += 4; y += 4; u += 4; v += 4;
+				count++;
+			}
+		}
+
+		// Borders are drawn at scale, so pick the level for the whole image at that size
+		drawQuads(region, z, nx, ny, count, selectMip(_width, _height, _width * scale, _height * scale), rgba, 0);
+	}
+
+	void Image::DrawTiled(RectangleF * region, float z, float tileW, float tileH, unsigned int rgba) {
+		float * x, * y, * u, * v, tx, ty, tw, th, w, h, nx, ny, x0, y0;
+		int cols, rows, level, i, j;
+		bool repeat;
+		Vector2 * pos;
+
+		if (!region || _mini == NULL || !_textureOff || _width <= 0 || _height <= 0)
+			return;
+
+		if (tileW <= 0)
+			tileW = _width;
+		if (tileH <= 0)
+			tileH = _height;
+
+		w = region->W();
+		h = region->H();
+		nx = region->X();
+		ny = region->Y();
+		if (region->UseAnchor) {
+			pos = region->GetRotatedCenter();
+			nx = pos->X;
+			ny = pos->Y;
+		}
+		x0 = nx - w / 2;
+		y0 = ny - h / 2;
+		if (w <= 0 || h <= 0)
+			return;
+
+		level = selectMip(_width, _height, tileW, tileH);
+
+		// The RSX only wraps power of two textures
+		repeat = !(_texture.Mips[level].Width & (_texture.Mips[level].Width - 1))
+			&& !(_texture.Mips[level].Height & (_texture.Mips[level].Height - 1));
+
+		if (repeat) {
+			reserveQuads(1);
+			x = &_quads[0]; y = x + 4; u = y + 4; v = u + 4;
+
+			x[0] = x0;     y[0] = y0;     u[0] = 0;         v[0] = 0;
+			x[1] = x0 + w; y[1] = y0;     u[1] = w / tileW; v[1] = 0;
+			x[2] = x0 + w; y[2] = y0 + h; u[2] = w / tileW; v[2] = h / tileH;
+			x[3] = x0;     y[3] = y0 + h; u[3] = 0;         v[3] = h / tileH;
+
+			drawQuads(region, z, nx, ny, 1, level, rgba, 1);
+			return;
+		}
+
+		// One quad per tile, cutting the last row and column short. Tiles too small for the region are grown to bound the quads
+		if (w / tileW > IMAGE_TILED_MAX)
+			tileW = w / IMAGE_TILED_MAX;
+		if (h / tileH > IMAGE_TILED_MAX)
+			tileH = h / IMAGE_TILED_MAX;
+		cols = (int)fmin(ceilf(w / tileW), IMAGE_TILED_MAX);
+		rows = (int)fmin(ceilf(h / tileH), IMAGE_TILED_MAX);
+		reserveQuads(cols * rows);
+		x = &_quads[0]; y = x + cols * rows * 4; u = y + cols * rows * 4; v = u + cols * rows * 4;
+
+		for (j = 0; j < rows; j++) {
+			ty = y0 + j * tileH;
+			th = fmin(tileH, y0 + h - ty);
+			for (i = 0; i < cols; i++) {
+				tx = x0 + i * tileW;
+				tw = fmin(tileW, x0 + w - tx);
+
+				x[0] = tx;      y[0] = ty;      u[0] = 0;                        v[0] = 0;
+				x[1] = tx + tw; y[1] = ty;      u[1] = 0.999999f * tw / tileW;   v[1] = 0;
+				x[2] = tx + tw; y[2] = ty + th; u[2] = u[1];                     v[2] = 0.999999f * th / tileH;
+				x[3] = tx;      y[3] = ty + th; u[3] = 0;                        v[3] = v[2];
+				x += 4; y += 4; u += 4; v += 4;
+			}
+		}
+
+		drawQuads(region, z, nx, ny, cols * rows, level, rgba, 0);
+	}
+
+	void Image::DrawQuads(const float * x, const float * y, int count, float z, const unsigned int * rgba, float size) {
+		TextureCache::TextureMip * mip;
+
+		if (_mini == NULL || !_textureOff || !x || !y || !rgba || count <= 0)
+			return;
+
+		// Null texture coordinates map the whole texture onto each quad
+		mip = &_texture.Mips[size > 0 ? selectMip(_width, _height, size, size) : 0];
+		_mini->DrawTextureQuads(mip->TextureOff, mip->Pitch, mip->Width, mip->Height, x, y, NULL, NULL, count, z, rgba, Pixel::GetTiny3DFormat(_texture.Format));
+	}
+
+	void Image::reserveQuads(int count) {
+		if ((int)_quads.size() < count * 16)
+			_quads.resize(count * 16);
+		if ((int)_quadColors.size() < count)
+			_quadColors.resize(count);
+	}
+
+	void Image::drawQuads(RectangleF * region, float z, float nx, float ny, int count, int level, unsigned int rgba, bool repeat) {
+		float * x = &_quads[0], * y = x + count * 4, * u = y + count * 4, * v = u + count * 4;
+		TextureCache::TextureMip * mip = &_texture.Mips[level];
+		int i;
+
+		if (count <= 0)
+			return;
+
+		if (region->RectangleAngle != 0) {
+			Vector2 center(nx, ny);
+			Vector2::RotateAroundPoint(x, y, count * 4, &center, region->RectangleAngle);
+		}
+
+		for (i = 0; i < count; i++)
+			_quadColors[i] = rgba;
+
+		_mini->DrawTextureQuads(mip->TextureOff, mip->Pitch, mip->Width, mip->Height, x, y, u, v, count, z, &_quadColors[0], Pixel::GetTiny3DFormat(_texture.Format), repeat);
+	}
+
+	void Image::draw(RectangleF * region, float z, float u0, float v0, float u1, float v1, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL) {
 		if (_mini == NULL || !_textureOff)
 			return;
 
-		float w = DrawRegion.W(), h = DrawRegion.H();
-		float nx = DrawRegion.X(), ny = DrawRegion.Y();
-		if (DrawRegion.UseAnchor) {
-			Vector2 * pos = DrawRegion.GetRotatedCenter();
+		float w = region->W(), h = region->H();
+		float nx = region->X(), ny = region->Y();
+		if (region->UseAnchor) {
+			Vector2 * pos = region->GetRotatedCenter();
 			nx = pos->X;
 			ny = pos->Y;
 		}
 
 		float ax = nx, ay = ny;
 
-		_mini->DrawTexture(_textureOff, _pitch, _width, _height, ax, ay, nx, ny, ZIndex, w, h, rgbaTL, rgbaTR, rgbaBR, rgbaBL, -DrawRegion.RectangleAngle, TINY3D_TEX_FORMAT_A8R8G8B8);
-	}
+		// Texture coordinates are normalized so they apply to every level
+		TextureCache::TextureMip * mip = &_texture.Mips[selectMip(fabs(u1 - u0) * _width, fabs(v1 - v0) * _height, w, h)];
 
-	void Image::Draw(unsigned int rgba) {
-		Draw(rgba, rgba, rgba, rgba);
+		_mini->DrawTextureRegion(mip->TextureOff, mip->Pitch, mip->Width, mip->Height, ax, ay, nx, ny, z, w, h, u0, v0, u1, v1, rgbaTL, rgbaTR, rgbaBR, rgbaBL, -region->RectangleAngle, Pixel::GetTiny3DFormat(_texture.Format));
 	}
 
 	//---------------------------------------------------------------------------
@@ -201,4 +729,39 @@ namespace Mini2D {
 		return _pitch;
 	}
 
+	Pixel::PixelFormat Image::GetFormat() {
+		return _texture.Format;
+	}
+
+	int Image::GetMipCount() {
+		return _texture.MipCount;
+	}
+
+	//---------------------------------------------------------------------------
+	// Private Functions
+	//---------------------------------------------------------------------------
+	static void convertBands(void * data, int start, int end) {
+		PixelBands * bands = (PixelBands *)data;
+		int y, h, outPitch = Pixel::GetPitch(bands->Format, bands->Width);
+
+		for (; start < end; start++) {
+			y = start * BAND_ROWS;
+			h = bands->Height - y < BAND_ROWS ? bands->Height - y : BAND_ROWS;
+			if (!Pixel::Convert((const unsigned int*)((const unsigned char*)bands->ARGB + y * bands->Pitch), bands->Width, h, bands->Pitch,
+					bands->Format, bands->Out + outPitch * Pixel::GetRows(bands->Format, y)))
+				bands->Failed = 1;
+		}
+	}
+
+	static void premultiplyBands(void * data, int start, int end) {
+		PixelBands * bands = (PixelBands *)data;
+		int y, h;
+
+		for (; start < end; start++) {
+			y = start * BAND_ROWS;
+			h = bands->Height - y < BAND_ROWS ? bands->Height - y : BAND_ROWS;
+			Pixel::Premultiply((unsigned int*)((unsigned char*)bands->ARGB + y * bands->Pitch), bands->Width, h, bands->Pitch);
+		}
+	}
+
 }
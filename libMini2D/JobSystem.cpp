@@ -0,0 +1,280 @@
+/*
+ * JobSystem.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <string.h>                              // memset
+
+#include <Mini2D/JobSystem.hpp>                  // Class definition
+
+#define WORKER_PRIORITY    1000
+#define WORKER_STACK       0x10000
+#define WORKER_SPINS       64                    // Empty searches before a worker sleeps
+#define RANGES_PER_THREAD  4                     // Ranges ParallelFor gives each thread when no grain is set
+#define WAKE_MAX           0x7FFFFFFF            // Count limit of the wake semaphore. Workers that find a job after announcing a sleep leave posts behind
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	JobSystem::JobSystem(int workers) {
+		sys_sem_attr_t attr;
+		int i;
+
+		_exit = 0;
+		_sleeping = 0;
+		_workerCount = workers > 0 ? workers : 0;
+		_workers = new Worker[_workerCount + 1];
+		for (i = 0; i <= _workerCount; i++) {
+			_workers[i].System = this;
+			_workers[i].Thread = 0;
+			_workers[i].Running = 0;
+			_workers[i].Lock = 0;
+			_workers[i].Top = 0;
+			_workers[i].Bottom = 0;
+		}
+
+		memset(&attr, 0, sizeof(sys_sem_attr_t));
+		attr.attr_protocol = SYS_SEM_ATTR_PROTOCOL;
+		attr.attr_pshared = SYS_SEM_ATTR_PSHARED;
+		sysSemCreate(&_wake, &attr, 0, WAKE_MAX);
+
+		// A thread that fails to start leaves its queue empty. Jobs still run on the others or on joining threads
+		for (i = 0; i < _workerCount; i++)
+			_workers[i].Running = !sysThreadCreate(&_workers[i].Thread, workerThread, &_workers[i], WORKER_PRIORITY, WORKER_STACK, THREAD_JOINABLE, "Mini2D job worker");
+	}
+
+	JobSystem::~JobSystem() {
+		u64 result;
+		int i;
+
+		_exit = 1;
+		__sync_synchronize();
+
+		// One post per worker, each on its own so a full count can't drop the rest
+		for (i = 0; i < _workerCount; i++)
+			if (_workers[i].Running)
+				sysSemPost(_wake, 1);
+		for (i = 0; i < _workerCount; i++)
+			if (_workers[i].Running)
+				sysThreadJoin(_workers[i].Thread, &result);
+
+		sysSemDestroy(_wake);
+		delete[] _workers;
+		_workers = NULL;
+	}
+
+	//---------------------------------------------------------------------------
+	// Job Functions
+	//---------------------------------------------------------------------------
+	void JobSystem::Fork(JobHandle * handle, JobFunction_f function, void * data, int start, int end) {
+		Job job;
+
+		if (!handle || !function)
+			return;
+
+		job.Function = function;
+		job.Data = data;
+		job.Start = start;
+		job.End = end;
+		job.Handle = handle;
+		__sync_fetch_and_add(&handle->Pending, 1);
+
+		if (!push(current(), &job))
+			run(&job);
+		else
+			wake(1);
+	}
+
+	void JobSystem::Join(JobHandle * handle) {
+		int queue = current();
+		Job job;
+
+		if (!handle)
+			return;
+
+		while (handle->Pending > 0) {
+			if (find(queue, &job))
+				run(&job);
+			else
+				sysThreadYield();
+		}
+		__sync_synchronize();
+	}
+
+	void JobSystem::ParallelFor(JobFunction_f function, void * data, int count, int grain) {
+		JobHandle handle = { 0 };
+		int queue = current(), start, end;
+		Job job;
+
+		if (!function || count <= 0)
+			return;
+
+		if (grain <= 0)
+			grain = (count + (_workerCount + 1) * RANGES_PER_THREAD - 1) / ((_workerCount + 1) * RANGES_PER_THREAD);
+
+		// Queue every range but the first before waking anyone, then take the first ourselves
+		for (start = grain; start < count; start = end) {
+			end = count - start < grain ? count : start + grain;
+
+			job.Function = function;
+			job.Data = data;
+			job.Start = start;
+			job.End = end;
+			job.Handle = &handle;
+			__sync_fetch_and_add(&handle.Pending, 1);
+			if (!push(queue, &job))
+				run(&job);
+		}
+		if (handle.Pending > 0)
+			wake(_workerCount);
+
+		function(data, 0, grain < count ? grain : count);
+		Join(&handle);
+	}
+
+	int JobSystem::current() {
+		sys_ppu_thread_t thread;
+		int i;
+
+		if (sysThreadGetId(&thread))
+			return _workerCount;
+
+		for (i = 0; i < _workerCount; i++)
+			if (_workers[i].Running && _workers[i].Thread == thread)
+				return i;
+		return _workerCount;
+	}
+
+	bool JobSystem::push(int queue, const Job * job) {
+		Worker * worker = &_workers[queue];
+		bool pushed = 0;
+
+		while (__sync_lock_test_and_set(&worker->Lock, 1))
+			while (worker->Lock) ;
+
+		if (worker->Bottom - worker->Top < JOB_QUEUE_SIZE) {
+			worker->Jobs[worker->Bottom & (JOB_QUEUE_SIZE - 1)] = *job;
+			worker->Bottom++;
+			pushed = 1;
+		}
+
+		__sync_lock_release(&worker->Lock);
+		return pushed;
+	}
+
+	bool JobSystem::pop(int queue, Job * job) {
+		Worker * worker = &_workers[queue];
+		bool popped = 0;
+
+		// Checked without the lock first so idle threads do not fight over empty queues
+		if (worker->Bottom == worker->Top)
+			return 0;
+
+		while (__sync_lock_test_and_set(&worker->Lock, 1))
+			while (worker->Lock) ;
+
+		if (worker->Bottom != worker->Top) {
+			worker->Bottom--;
+			*job = worker->Jobs[worker->Bottom & (JOB_QUEUE_SIZE - 1)];
+			popped = 1;
+		}
+
+		__sync_lock_release(&worker->Lock);
+		return popped;
+	}
+
+	bool JobSystem::steal(int queue, Job * job) {
+		Worker * worker = &_workers[queue];
+		bool stolen = 0;
+
+		if (worker->Bottom == worker->Top)
+			return 0;
+
+		while (__sync_lock_test_and_set(&worker->Lock, 1))
+			while (worker->Lock) ;
+
+		if (worker->Bottom != worker->Top) {
+			*job = worker->Jobs[worker->Top & (JOB_QUEUE_SIZE - 1)];
+			worker->Top++;
+			stolen = 1;
+		}
+
+		__sync_lock_release(&worker->Lock);
+		return stolen;
+	}
+
+	bool JobSystem::find(int queue, Job * job) {
+		int i, count = _workerCount + 1;
+
+		if (pop(queue, job))
+			return 1;
+
+		// Start with the next queue so thieves spread out
+		for (i = 1; i < count; i++)
+			if (steal((queue + i) % count, job))
+				return 1;
+		return 0;
+	}
+
+	void JobSystem::run(Job * job) {
+		job->Function(job->Data, job->Start, job->End);
+
+		// Results must be visible before the joining thread sees the count drop
+		__sync_synchronize();
+		__sync_fetch_and_sub(&job->Handle->Pending, 1);
+	}
+
+	void JobSystem::wake(int count) {
+		int sleeping;
+
+		__sync_synchronize();
+		sleeping = _sleeping;
+		if (sleeping > 0)
+			sysSemPost(_wake, count < sleeping ? count : sleeping);
+	}
+
+	void JobSystem::workerThread(void * worker) {
+		JobSystem * self = ((Worker *)worker)->System;
+		int queue = (Worker *)worker - self->_workers, spins = 0;
+		Job job;
+
+		while (!self->_exit) {
+			if (self->find(queue, &job)) {
+				self->run(&job);
+				spins = 0;
+				continue;
+			}
+
+			if (++spins < WORKER_SPINS) {
+				sysThreadYield();
+				continue;
+			}
+
+			// Announce the sleep before looking once more, so a job queued in between is either seen here or wakes us
+			__sync_fetch_and_add(&self->_sleeping, 1);
+			if (self->find(queue, &job)) {
+				__sync_fetch_and_sub(&self->_sleeping, 1);
+				self->run(&job);
+			}
+			else {
+				sysSemWait(self->_wake, 0);
+				__sync_fetch_and_sub(&self->_sleeping, 1);
+			}
+			spins = 0;
+		}
+
+		sysThreadExit(0);
+	}
+
+	//---------------------------------------------------------------------------
+	// Get Functions
+	//---------------------------------------------------------------------------
+	int JobSystem::GetWorkerCount() {
+		return _workerCount;
+	}
+
+}
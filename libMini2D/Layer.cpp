@@ -0,0 +1,118 @@
+/*
+ * Layer.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <tiny3d.h>                              // Tiny3D functions
+#include <Mini2D/Layer.hpp>                      // Class definition
+
+// RSX render surfaces must start on, and have rows that are a multiple of, 64 bytes
+#define SURFACE_ALIGN 64
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	Layer::Layer(Mini * mini, int width, int height) :
+			_mini(mini) {
+		unsigned long aligned;
+
+		ZIndex = 0;
+		ClearColor = 0;
+
+		_width = width > 0 ? width : 0;
+		_height = height > 0 ? height : 0;
+		_pitch = (_width * 4 + SURFACE_ALIGN - 1) & ~(SURFACE_ALIGN - 1);
+		_size = 0;
+		_pointer = NULL;
+		_textureOff = 0;
+		_valid = 0;
+		_rendering = 0;
+
+		if (_mini == NULL || !_width || !_height)
+			return;
+
+		// The texture heap is only 16 byte aligned
+		_size = _pitch * _height + SURFACE_ALIGN;
+		_pointer = _mini->AllocTexture(_size, NULL);
+		if (!_pointer)
+			return;
+
+		aligned = ((unsigned long)_pointer + SURFACE_ALIGN - 1) & ~(unsigned long)(SURFACE_ALIGN - 1);
+		_textureOff = tiny3d_TextureOffset((void*)aligned);
+
+		DrawRegion = RectangleF(_width / 2.f, _height / 2.f, _width, _height);
+	}
+
+	Layer::~Layer() {
+		if (_rendering)
+			End();
+		if (_mini && _pointer)
+			_mini->FreeTexture(_pointer, _size);
+
+		_mini = NULL;
+		_pointer = NULL;
+		_textureOff = 0;
+	}
+
+	//---------------------------------------------------------------------------
+	// Render Functions
+	//---------------------------------------------------------------------------
+	bool Layer::Begin() {
+		if (_valid || _rendering || !_textureOff)
+			return 0;
+
+		_rendering = _mini->BeginRenderTarget(_textureOff, _width, _height, _pitch, ClearColor);
+		return _rendering;
+	}
+
+	void Layer::End() {
+		if (!_rendering)
+			return;
+
+		_mini->EndRenderTarget();
+		_rendering = 0;
+		_valid = 1;
+	}
+
+	void Layer::Invalidate() {
+		_valid = 0;
+	}
+
+	bool Layer::IsValid() {
+		return _valid;
+	}
+
+	//---------------------------------------------------------------------------
+	// Draw Functions
+	//---------------------------------------------------------------------------
+	void Layer::Draw(unsigned int rgba) {
+		if (_mini == NULL || !_valid)
+			return;
+
+		float w = DrawRegion.W(), h = DrawRegion.H();
+		float nx = DrawRegion.X(), ny = DrawRegion.Y();
+		if (DrawRegion.UseAnchor) {
+			Vector2 * pos = DrawRegion.GetRotatedCenter();
+			nx = pos->X;
+			ny = pos->Y;
+		}
+
+		_mini->DrawTexture(_textureOff, _pitch, _width, _height, nx, ny, nx, ny, ZIndex, w, h, rgba, -DrawRegion.RectangleAngle, TINY3D_TEX_FORMAT_A8R8G8B8);
+	}
+
+	//---------------------------------------------------------------------------
+	// Get Functions
+	//---------------------------------------------------------------------------
+	int Layer::GetWidth() {
+		return _width;
+	}
+
+	int Layer::GetHeight() {
+		return _height;
+	}
+
+}
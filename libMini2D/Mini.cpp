@@ -20,6 +20,9 @@
 
 #include <tiny3d.h>                              // Tiny3D functions
 #include <Mini2D/Mini.hpp>                       // Class definition
+#include <Mini2D/Camera.hpp>                     // Camera class
+#include <Mini2D/TextureCache.hpp>               // TextureCache class
+#include <Mini2D/JobSystem.hpp>                  // JobSystem class
 
 
 #define ANA_DIF_SHIFT(a,b,d,r) ((a==b) ? 0 : ((a<b) ? ((b-a)>=d ? r : 0) : (((a-b)>=d ? r : 0))))
@@ -29,6 +32,12 @@
 #define INITED_SOUNDLIB     4
 #define INITED_AUDIOPLAYER  8
 
+#define TEXTURE_HEAP_SIZE   (64*1024*1024)
+#define JOB_WORKERS         1                    // The PPU runs two hardware threads, one of them the caller's
+
+// Blend states are the blend mode, plus this flag when premultiplied
+#define BLEND_STATE_PREMULTIPLIED   4
+
 namespace Mini2D {
 
 	// Exit callback
@@ -40,6 +49,9 @@ namespace Mini2D {
 	// Convert degree angle to radians
 	float degToRad(float d);
 
+	// Current time (milliseconds)
+	double timeMs();
+
 	// Callback for system events
 	static void sys_callback(uint64_t status, uint64_t param, void* userdata);
 
@@ -59,8 +71,10 @@ namespace Mini2D {
 		_maxH = Video_Resolution.height;
 		_minH = 0;
 
-		_textureMem = tiny3d_AllocTexture(64*1024*1024);
+		_textureMem = tiny3d_AllocTexture(TEXTURE_HEAP_SIZE);
 		TexturePointer = (unsigned int*)_textureMem;
+		_textureCache = new TextureCache(this);
+		_jobSystem = new JobSystem(JOB_WORKERS);
 
 		// Init pad
 		ioPadInit(7);
@@ -81,8 +95,31 @@ namespace Mini2D {
 		_frameCount = 0;
 		_clearColor = 0xFF000000;
 		_alphaEnabled = 0;
+		_cullEnabled = 1;
+		_camera = NULL;
+		_drawQueue = NULL;
+		_renderTarget = 0;
+		_targetQueue = NULL;
+		_targetSpace = DRAW_SPACE_SCREEN;
+		_premultiplied = 0;
+		_blendMode = BLEND_NORMAL;
+		_blendState = -1;
+		_drawSpace = DRAW_SPACE_SCREEN;
+		updateView();
 		_analogDeadzone = 0;
 
+		memset(&_drawStats, 0, sizeof(DrawStats));
+		memset(&_lastDrawStats, 0, sizeof(DrawStats));
+
+		_pipelined = 0;
+		_pipelineRequest = 0;
+		memset(_frames, 0, sizeof(_frames));
+		_recordIndex = 0;
+		_pendingFrame = NULL;
+		_recordStart = timeMs();
+		memset(&_frameStats, 0, sizeof(FrameStats));
+		memset(&_renderStats, 0, sizeof(FrameStats));
+
 		XMB = 0;
 
 		// Clear padData buffers
@@ -120,6 +157,8 @@ namespace Mini2D {
 	}
 
 	Mini::~Mini() {
+		stopRender();
+
 		if(_spuInited & INITED_AUDIOPLAYER)
 	        StopAudio();
 
@@ -132,6 +171,14 @@ namespace Mini2D {
 	    }
 	    _spuInited = 0;
 
+		if (_textureCache)
+			delete _textureCache;
+		_textureCache = NULL;
+
+		if (_jobSystem)
+			delete _jobSystem;
+		_jobSystem = NULL;
+
 		unload();
 	}
 
@@ -186,14 +233,139 @@ namespace Mini2D {
 
 	void Mini::SetAlphaState(bool enable) {
 		_alphaEnabled = enable;
+
+		// While pipelined the blend cache belongs to the render thread, which resets it every frame.
+		// Render targets wait for that thread to go idle and draw here, so they reset it themselves
+		if (!_pipelined || _renderTarget)
+			_blendState = -1;
+	}
+
+	void Mini::SetPremultipliedAlpha(bool enable) {
+		_premultiplied = enable;
+		if (!_drawQueue)
+			setBlendState(blendState(), _alphaEnabled);
+	}
+
+	bool Mini::GetPremultipliedAlpha() {
+		return _premultiplied;
+	}
+
+	void Mini::SetBlendMode(BlendMode mode) {
+		_blendMode = mode;
+		if (!_drawQueue)
+			setBlendState(blendState(), _alphaEnabled);
+	}
+
+	Mini::BlendMode Mini::GetBlendMode() {
+		return _blendMode;
+	}
+
+	void Mini::SetCullState(bool enable) {
+		_cullEnabled = enable;
+	}
+
+	void Mini::SetCamera(Camera * camera) {
+		_camera = camera;
+		updateView();
+	}
+
+	void Mini::SetDrawSpace(DrawSpace space) {
+		_drawSpace = space;
+		updateView();
+	}
+
+	void Mini::SetDrawQueue(DrawQueue * queue) {
+		// While pipelined, null means the queue of the frame being recorded
+		_drawQueue = queue || !_pipelined ? queue : _frames[_recordIndex].Queue;
+		updateView();
+	}
+
+	void Mini::SetPipelined(bool enable) {
+		_pipelineRequest = enable;
+	}
+
+	bool Mini::GetPipelined() {
+		return _pipelined;
+	}
+
+	Mini::FrameStats Mini::GetFrameStats() {
+		return _frameStats;
+	}
+
+	bool Mini::BeginRenderTarget(unsigned int textureOff, int width, int height, int pitch, unsigned int clearColor) {
+		if (_renderTarget || !textureOff || width <= 0 || height <= 0 || pitch < width * 4 || (pitch & 63) || (textureOff & 63))
+			return 0;
+
+		// Queued draws would be submitted after the target is gone, so draw immediately.
+		// The render thread must be idle to share the RSX
+		waitForRender();
+		_renderTarget = 1;
+		_targetQueue = _drawQueue;
+		_targetSpace = _drawSpace;
+		_drawQueue = NULL;
+
+		tiny3d_ClearSurface(clearColor, TINY3D_CLEAR_ALL, textureOff, width, height, pitch, TINY3D_CLEAR_FORMAT_32);
+		applyState();
+		SetDrawSpace(DRAW_SPACE_SCREEN);
+
+		// Cull against the texture instead of the screen
+		_viewMinX = 0;
+		_viewMinY = 0;
+		_viewMaxX = width;
+		_viewMaxY = height;
+
+		return 1;
+	}
+
+	void Mini::EndRenderTarget() {
+		if (!_renderTarget)
+			return;
+
+		// Select the screen again without clearing it
+		tiny3d_Clear(_clearColor, (clear_flags)0);
+		applyState();
+
+		_renderTarget = 0;
+		_drawQueue = _targetQueue;
+		_targetQueue = NULL;
+		SetDrawSpace(_targetSpace);
+	}
+
+	float Mini::GetDrawScale() {
+		return _worldView ? _camera->Zoom : 1;
+	}
+
+	Mini::DrawStats Mini::GetDrawStats() {
+		return _lastDrawStats;
 	}
 
 	void Mini::SetAnalogDeadzone(unsigned char deadzone) {
 		_analogDeadzone = (unsigned short)deadzone;
 	}
 
+	TextureCache * Mini::GetTextureCache() {
+		return _textureCache;
+	}
+
+	JobSystem * Mini::GetJobSystem() {
+		return _jobSystem;
+	}
+
+	void Mini::SetJobWorkers(int workers) {
+		if (_jobSystem)
+			delete _jobSystem;
+		_jobSystem = new JobSystem(workers);
+	}
+
 	void Mini::ResetTexturePointer() {
+		// The frame in flight may still be drawing from the heap
+		waitForRender();
 		TexturePointer = (unsigned int*)_textureMem;
+		_freeTextures.clear();
+		_pendingTextures.clear();
+		_flightTextures.clear();
+		if (_textureCache)
+			_textureCache->Clear();
 	}
 
 	//---------------------------------------------------------------------------
@@ -206,17 +378,15 @@ namespace Mini2D {
 		gettimeofday(&_start, NULL);
 		while (1) {
 
-			// Setup frame
-			tiny3d_Clear(_clearColor, TINY3D_CLEAR_ALL);
+			// Setup frame. When pipelined the render thread clears and sets up the RSX before submitting
+			_blendMode = BLEND_NORMAL;
+			if (!_pipelined) {
+				tiny3d_Clear(_clearColor, TINY3D_CLEAR_ALL);
 
-			// Enable alpha Test
-			tiny3d_AlphaTest(_alphaEnabled, 0, TINY3D_ALPHA_FUNC_GEQUAL);
-			tiny3d_BlendFunc(_alphaEnabled, (blend_src_func)(TINY3D_BLEND_FUNC_SRC_RGB_SRC_ALPHA | TINY3D_BLEND_FUNC_SRC_ALPHA_SRC_ALPHA),
-								(blend_dst_func)(TINY3D_BLEND_FUNC_DST_RGB_ONE_MINUS_SRC_ALPHA | TINY3D_BLEND_FUNC_DST_ALPHA_ZERO),
-								(blend_func)(TINY3D_BLEND_RGB_FUNC_ADD | TINY3D_BLEND_ALPHA_FUNC_ADD));
-
-			// 2D context
-			tiny3d_Project2D();
+				// Enable alpha Test and 2D context
+				applyState();
+			}
+			SetDrawSpace(DRAW_SPACE_SCREEN);
 
 			// Process pad
 			if (_padCallback)
@@ -233,8 +403,51 @@ namespace Mini2D {
 	}
 
 	void Mini::Flip() {
-		// Flip frame
-		tiny3d_Flip();
+		double start = timeMs(), submitted;
+		RenderFrame * frame;
+
+		EndRenderTarget();
+
+		if (_pipelined) {
+			frame = &_frames[_recordIndex];
+			frame->ClearColor = _clearColor;
+			frame->AlphaEnabled = _alphaEnabled;
+			frame->RecordStart = _recordStart;
+
+			// Wait for the previous frame to be flipped. Its queue is then free to record the next frame into
+			sysSemWait(_frameDone, 0);
+			_frameStats = _renderStats;
+
+			// Blocks freed while the previous frame was recorded are no longer drawn from.
+			// The ones freed during this frame wait until it has been flipped too
+			releaseTextures(&_flightTextures);
+			_flightTextures.swap(_pendingTextures);
+			(void)__sync_lock_test_and_set(&_pendingFrame, frame);
+			sysSemPost(_frameReady, 1);
+
+			_recordIndex ^= 1;
+			_drawQueue = _frames[_recordIndex].Queue;
+		}
+		else {
+			// Submit deferred draws. Textures freed while they were queued can then be reused
+			submitQueue();
+			releaseTextures(&_pendingTextures);
+			submitted = timeMs();
+
+			// Flip frame
+			tiny3d_Flip();
+
+			_frameStats.SubmitTime = submitted - start;
+			_frameStats.FlipTime = timeMs() - submitted;
+			_frameStats.Latency = timeMs() - _recordStart;
+		}
+		_frameStats.RecordTime = start - _recordStart;
+
+		// Start or stop the render thread between frames
+		if (_pipelineRequest && !_pipelined)
+			startRender();
+		else if (!_pipelineRequest && _pipelined)
+			stopRender();
 
 		// Calculate deltaTime
 		gettimeofday(&_end, NULL);
@@ -244,6 +457,132 @@ namespace Mini2D {
 		_frameCount++;
 		if (_frameCount >= _maxFrameCount)
 			_frameCount = 0;
+
+		// Publish draw counts
+		_lastDrawStats = _drawStats;
+		memset(&_drawStats, 0, sizeof(DrawStats));
+
+		_frameStats.FrameTime = _deltaTime * 1000;
+		_recordStart = timeMs();
+	}
+
+	//---------------------------------------------------------------------------
+	// Render Thread Functions
+	//---------------------------------------------------------------------------
+	bool Mini::startRender() {
+		sys_sem_attr_t attr;
+		int i;
+
+		if (_pipelined)
+			return 1;
+
+		memset(&attr, 0, sizeof(sys_sem_attr_t));
+		attr.attr_protocol = SYS_SEM_ATTR_PROTOCOL;
+		attr.attr_pshared = SYS_SEM_ATTR_PSHARED;
+
+		// The render thread starts idle. On failure drawing stays immediate
+		_pipelineRequest = 0;
+		if (sysSemCreate(&_frameReady, &attr, 0, 1))
+			return 0;
+		if (sysSemCreate(&_frameDone, &attr, 1, 1)) {
+			sysSemDestroy(_frameReady);
+			return 0;
+		}
+
+		for (i = 0; i < 2; i++)
+			_frames[i].Queue = new DrawQueue();
+		_recordIndex = 0;
+		_pendingFrame = NULL;
+		memset(&_renderStats, 0, sizeof(FrameStats));
+
+		if (sysThreadCreate(&_renderThread, renderThread, this, 1000, 0x10000, THREAD_JOINABLE, "Mini2D render")) {
+			for (i = 0; i < 2; i++) {
+				delete _frames[i].Queue;
+				_frames[i].Queue = NULL;
+			}
+			sysSemDestroy(_frameReady);
+			sysSemDestroy(_frameDone);
+			return 0;
+		}
+
+		_pipelined = 1;
+		_pipelineRequest = 1;
+		SetDrawQueue(NULL);
+		return 1;
+	}
+
+	void Mini::stopRender() {
+		u64 result;
+		int i;
+
+		if (!_pipelined)
+			return;
+
+		// Handing over null tells the render thread to exit once idle
+		waitForRender();
+		(void)__sync_lock_test_and_set(&_pendingFrame, (RenderFrame*)NULL);
+		sysSemPost(_frameReady, 1);
+		sysThreadJoin(_renderThread, &result);
+
+		sysSemDestroy(_frameReady);
+		sysSemDestroy(_frameDone);
+		releaseTextures(&_flightTextures);
+
+		if (_drawQueue == _frames[_recordIndex].Queue)
+			_drawQueue = NULL;
+		for (i = 0; i < 2; i++) {
+			delete _frames[i].Queue;
+			_frames[i].Queue = NULL;
+		}
+
+		_pipelined = 0;
+		_pipelineRequest = 0;
+		updateView();
+	}
+
+	void Mini::waitForRender() {
+		if (!_pipelined)
+			return;
+
+		sysSemWait(_frameDone, 0);
+		sysSemPost(_frameDone, 1);
+	}
+
+	void Mini::renderThread(void * mini) {
+		((Mini*)mini)->renderLoop();
+		sysThreadExit(0);
+	}
+
+	void Mini::renderLoop() {
+		RenderFrame * frame;
+		double start, submitted;
+
+		while (1) {
+			sysSemWait(_frameReady, 0);
+			frame = __sync_lock_test_and_set(&_pendingFrame, (RenderFrame*)NULL);
+			if (!frame)
+				break;
+
+			// Same setup BeginDrawLoop does for immediate frames
+			start = timeMs();
+			tiny3d_Clear(frame->ClearColor, TINY3D_CLEAR_ALL);
+			tiny3d_AlphaTest(frame->AlphaEnabled, 0, TINY3D_ALPHA_FUNC_GEQUAL);
+			_blendState = -1;
+			tiny3d_Project2D();
+
+			if (frame->Queue->Count())
+				submit(frame->Queue, frame->AlphaEnabled);
+			frame->Queue->Clear();
+			submitted = timeMs();
+
+			tiny3d_Flip();
+
+			_renderStats.SubmitTime = submitted - start;
+			_renderStats.FlipTime = timeMs() - submitted;
+			_renderStats.Latency = timeMs() - frame->RecordStart;
+
+			sysSemPost(_frameDone, 1);
+		}
 	}
 
 	void Mini::Pad() {
@@ -309,22 +648,183 @@ namespace Mini2D {
 		return textureOff;
 	}
 
-	void Mini::DrawTexture(u32 textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle, unsigned int colorFormat) {
+	void * Mini::AllocTexture(unsigned int size, unsigned int * textureOff) {
+		void * pointer = TexturePointer;
+		unsigned int i;
+
+		size = (size + 15) & ~15;
+
+		// First fit from freed blocks
+		for (i = 0; i < _freeTextures.size(); i++) {
+			if (_freeTextures[i].size < size)
+				continue;
+
+			pointer = _freeTextures[i].pointer;
+			if (_freeTextures[i].size == size)
+				_freeTextures.erase(_freeTextures.begin() + i);
+			else {
+				_freeTextures[i].pointer += size;
+				_freeTextures[i].size -= size;
+			}
+
+			if (textureOff)
+				*textureOff = tiny3d_TextureOffset(pointer);
+			return pointer;
+		}
+
+		if (((unsigned char*)TexturePointer + size) > ((unsigned char*)_textureMem + TEXTURE_HEAP_SIZE))
+			return NULL;
+
+		if (textureOff)
+			*textureOff = tiny3d_TextureOffset(TexturePointer);
+		TexturePointer += size / 4;
+
+		return pointer;
+	}
+
+	void Mini::FreeTexture(void * pointer, unsigned int size) {
+		TextureBlock block;
+
+		if (!pointer || !size)
+			return;
+
+		block.pointer = (unsigned char*)pointer;
+		block.size = (size + 15) & ~15;
+
+		// Queued draws may still sample the block, so it is only reused once they have been submitted
+		if (_pipelined || (_drawQueue && _drawQueue->Count()) || (_targetQueue && _targetQueue->Count()))
+			_pendingTextures.push_back(block);
+		else
+			releaseTexture(block);
+	}
+
+	void Mini::releaseTexture(TextureBlock block) {
+		unsigned int i;
+
+		// Insert sorted by address and merge with neighbours
+		for (i = 0; i < _freeTextures.size() && _freeTextures[i].pointer < block.pointer; i++) ;
+		if (i > 0 && _freeTextures[i-1].pointer + _freeTextures[i-1].size == block.pointer) {
+			i--;
+			_freeTextures[i].size += block.size;
+		}
+		else
+			_freeTextures.insert(_freeTextures.begin() + i, block);
+
+		if (i + 1 < _freeTextures.size() && _freeTextures[i].pointer + _freeTextures[i].size == _freeTextures[i+1].pointer) {
+			_freeTextures[i].size += _freeTextures[i+1].size;
+			_freeTextures.erase(_freeTextures.begin() + i + 1);
+		}
+
+		// A block that ends at the top of the heap gives its space back to the bump pointer
+		if (!_freeTextures.empty()) {
+			TextureBlock& last = _freeTextures.back();
+			if (last.pointer + last.size == (unsigned char*)TexturePointer) {
+				TexturePointer = (unsigned int*)last.pointer;
+				_freeTextures.pop_back();
+			}
+		}
+	}
+
+	void Mini::releaseTextures(std::vector<TextureBlock> * blocks) {
+		unsigned int i;
+
+		for (i = 0; i < blocks->size(); i++)
+			releaseTexture((*blocks)[i]);
+		blocks->clear();
+	}
+
+	void Mini::DrawTexture(unsigned int textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle, unsigned int colorFormat) {
+		DrawTextureRegion(textureOff, pitch, width, height, xAnchor, yAnchor, x, y, z, w, h, 0.0f, 0.0f, 0.999999f, 0.999999f, rgbaTL, rgbaTR, rgbaBR, rgbaBL, angle, colorFormat);
+	}
+
+	void Mini::DrawTextureRegion(unsigned int textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, float u0, float v0, float u1, float v1, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle, unsigned int colorFormat) {
+		DrawQueue::DrawCommand command;
+
+		if (cullRectangle(xAnchor, yAnchor, x, y, w, h, angle))
+			return;
+
+		rgbaTL = blendColor(rgbaTL);
+		rgbaTR = blendColor(rgbaTR);
+		rgbaBR = blendColor(rgbaBR);
+		rgbaBL = blendColor(rgbaBL);
+
+		if (_drawQueue) {
+			initCommand(&command, DrawQueue::DRAW_COMMAND_TEXTURE, z);
+			command.TextureOff = textureOff;
+			command.Pitch = pitch;
+			command.Width = width;
+			command.Height = height;
+			command.ColorFormat = colorFormat;
+			command.XAnchor = xAnchor;
+			command.YAnchor = yAnchor;
+			command.X = x;
+			command.Y = y;
+			command.W = w;
+			command.H = h;
+			command.Angle = angle;
+			command.U0 = u0;
+			command.V0 = v0;
+			command.U1 = u1;
+			command.V1 = v1;
+			command.RGBA[0] = rgbaTL;
+			command.RGBA[1] = rgbaTR;
+			command.RGBA[2] = rgbaBR;
+			command.RGBA[3] = rgbaBL;
+			_drawQueue->Push(command);
+			return;
+		}
+
 		tiny3d_SetTextureWrap(0, textureOff, width, height, pitch,
 			(text_format)colorFormat, TEXTWRAP_CLAMP, TEXTWRAP_CLAMP, TEXTURE_LINEAR);
-		drawSpriteRot(xAnchor, yAnchor, x, y, z, w, h, rgbaTL, rgbaTR, rgbaBR, rgbaBL, angle);
+		drawSpriteRot(_worldView ? &_viewMatrix : NULL, xAnchor, yAnchor, x, y, z, w, h, u0, v0, u1, v1, rgbaTL, rgbaTR, rgbaBR, rgbaBL, angle);
 	}
 
-	void Mini::DrawTexture(u32 textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, unsigned int rgba, float angle, unsigned int colorFormat) {
+	void Mini::DrawTexture(unsigned int textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, unsigned int rgba, float angle, unsigned int colorFormat) {
 		DrawTexture(textureOff, pitch, width, height, xAnchor, yAnchor, x, y, z, w, h, rgba, rgba, rgba, rgba, angle, colorFormat);
 	}
 
-	void Mini::DrawTexture(u32 textureOff, int pitch, int width, int height, float x, float y, float z, float w, float h, unsigned int rgba, float angle, unsigned int colorFormat) {
+	void Mini::DrawTexture(unsigned int textureOff, int pitch, int width, int height, float x, float y, float z, float w, float h, unsigned int rgba, float angle, unsigned int colorFormat) {
 		DrawTexture(textureOff, pitch, width, height, x, y, x, y, z, w, h, rgba, angle, colorFormat);
 	}
 
 	void Mini::DrawRectangle(float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, unsigned int rgba, float angle) {
+		DrawRectangle(xAnchor, yAnchor, x, y, layer, dx, dy, rgba, rgba, rgba, rgba, angle);
+	}
+
+	void Mini::DrawRectangle(float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle) {
+		DrawQueue::DrawCommand command;
+
+		if (cullRectangle(xAnchor, yAnchor, x, y, dx, dy, angle))
+			return;
+
+		rgbaTL = blendColor(rgbaTL);
+		rgbaTR = blendColor(rgbaTR);
+		rgbaBR = blendColor(rgbaBR);
+		rgbaBL = blendColor(rgbaBL);
+
+		if (_drawQueue) {
+			initCommand(&command, DrawQueue::DRAW_COMMAND_RECTANGLE, layer);
+			command.XAnchor = xAnchor;
+			command.YAnchor = yAnchor;
+			command.X = x;
+			command.Y = y;
+			command.W = dx;
+			command.H = dy;
+			command.Angle = angle;
+			command.RGBA[0] = rgbaTL;
+			command.RGBA[1] = rgbaTR;
+			command.RGBA[2] = rgbaBR;
+			command.RGBA[3] = rgbaBL;
+			_drawQueue->Push(command);
+			return;
+		}
+
+		drawRectangle(_worldView ? &_viewMatrix : NULL, xAnchor, yAnchor, x, y, layer, dx, dy, rgbaTL, rgbaTR, rgbaBR, rgbaBL, angle);
+	}
+
+	void Mini::drawRectangle(const MATRIX * view, float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle) {
 		MATRIX matrix;
+
 		dx/=2;
 		dy/=2;
 
@@ -332,6 +832,8 @@ namespace Mini2D {
 		angle = degToRad(angle);
 		matrix = MatrixRotationZ(angle);
 		matrix = MatrixMultiply(matrix, MatrixTranslation(xAnchor, yAnchor, 0.0f));
+		if (view)
+			matrix = MatrixMultiply(matrix, *view);
 
 		// Translate relative to anchor point based on angle
 		x-=xAnchor;
@@ -342,18 +844,419 @@ namespace Mini2D {
 		tiny3d_SetPolygon(TINY3D_QUADS);
 
 		tiny3d_VertexPos(x-dx	 , y-dy	 , layer);
-		tiny3d_VertexColor(rgba);
+		tiny3d_VertexColor(rgbaTL);
 
 		tiny3d_VertexPos(x + dx, y-dy	 , layer);
+		tiny3d_VertexColor(rgbaTR);
 
 		tiny3d_VertexPos(x + dx, y + dy, layer);
+		tiny3d_VertexColor(rgbaBR);
 
 		tiny3d_VertexPos(x-dx	 , y + dy, layer);
+		tiny3d_VertexColor(rgbaBL);
+
+		tiny3d_End();
+	}
+
+	void Mini::DrawTextureQuads(unsigned int textureOff, int pitch, int width, int height, const float * x, const float * y, const float * u, const float * v, int count, float z, const unsigned int * rgba, unsigned int colorFormat, bool repeat) {
+		static const float quadU[4] = { 0.0f, 0.999999f, 0.999999f, 0.0f };
+		static const float quadV[4] = { 0.0f, 0.0f, 0.999999f, 0.999999f };
+		DrawQueue::DrawCommand command;
+		unsigned int color;
+		int i, k, first;
+
+		if (!x || !y || count <= 0)
+			return;
+
+		if (_drawQueue) {
+			initCommand(&command, DrawQueue::DRAW_COMMAND_TEXTURE_QUADS, z);
+			command.TextureOff = textureOff;
+			command.Pitch = pitch;
+			command.Width = width;
+			command.Height = height;
+			command.ColorFormat = colorFormat;
+			command.Repeat = repeat;
+			queueQuads(&command, x, y, u, v, count, rgba);
+			return;
+		}
+
+		// Find the first visible quad so that nothing is sent if every quad is culled
+		for (first = 0; first < count; first++)
+			if (!cullQuad(x+first*4, y+first*4))
+				break;
+		if (first == count)
+			return;
+
+		tiny3d_SetTextureWrap(0, textureOff, width, height, pitch,
+			(text_format)colorFormat, repeat ? TEXTWRAP_REPEAT : TEXTWRAP_CLAMP, repeat ? TEXTWRAP_REPEAT : TEXTWRAP_CLAMP, TEXTURE_LINEAR);
+
+		// Vertices are already transformed, only the camera is applied
+		tiny3d_SetMatrixModelView(_worldView ? &_viewMatrix : NULL);
+
+		tiny3d_SetPolygon(TINY3D_QUADS);
+
+		for (i = first; i < count; i++) {
+			if (i > first && cullQuad(x+i*4, y+i*4))
+				continue;
+
+			color = blendColor(rgba ? rgba[i] : 0xFFFFFFFF);
+			for (k = i*4; k < (i+1)*4; k++) {
+				tiny3d_VertexPos(x[k], y[k], z);
+				tiny3d_VertexColor(color);
+				if (u && v)
+					tiny3d_VertexTexture(u[k], v[k]);
+				else
+					tiny3d_VertexTexture(quadU[k&3], quadV[k&3]);
+			}
+			_drawStats.Submitted++;
+		}
 
 		tiny3d_End();
 	}
 
-	void Mini::drawSpriteRot(float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, u32 rgba0, u32 rgba1, u32 rgba2, u32 rgba3, float angle) {
+	void Mini::DrawRectangleQuads(const float * x, const float * y, int count, float z, const unsigned int * rgba) {
+		DrawQueue::DrawCommand command;
+		unsigned int color;
+		int i, k, first;
+
+		if (!x || !y || !rgba || count <= 0)
+			return;
+
+		if (_drawQueue) {
+			initCommand(&command, DrawQueue::DRAW_COMMAND_RECTANGLE_QUADS, z);
+			queueQuads(&command, x, y, NULL, NULL, count, rgba);
+			return;
+		}
+
+		// Find the first visible quad so that nothing is sent if every quad is culled
+		for (first = 0; first < count; first++)
+			if (!cullQuad(x+first*4, y+first*4))
+				break;
+		if (first == count)
+			return;
+
+		// Vertices are already transformed, only the camera is applied
+		tiny3d_SetMatrixModelView(_worldView ? &_viewMatrix : NULL);
+
+		tiny3d_SetPolygon(TINY3D_QUADS);
+
+		for (i = first; i < count; i++) {
+			if (i > first && cullQuad(x+i*4, y+i*4))
+				continue;
+
+			color = blendColor(rgba[i]);
+			for (k = i*4; k < (i+1)*4; k++) {
+				tiny3d_VertexPos(x[k], y[k], z);
+				tiny3d_VertexColor(color);
+			}
+			_drawStats.Submitted++;
+		}
+
+		tiny3d_End();
+	}
+
+	void Mini::DrawColoredQuads(const float * x, const float * y, int count, float z, const unsigned int * rgba) {
+		DrawQueue::DrawCommand command;
+		int i, k, first;
+
+		if (!x || !y || !rgba || count <= 0)
+			return;
+
+		if (_drawQueue) {
+			initCommand(&command, DrawQueue::DRAW_COMMAND_RECTANGLE_QUADS, z);
+			queueQuads(&command, x, y, NULL, NULL, count, rgba, 1);
+			return;
+		}
+
+		// Find the first visible quad so that nothing is sent if every quad is culled
+		for (first = 0; first < count; first++)
+			if (!cullQuad(x+first*4, y+first*4))
+				break;
+		if (first == count)
+			return;
+
+		// Vertices are already transformed, only the camera is applied
+		tiny3d_SetMatrixModelView(_worldView ? &_viewMatrix : NULL);
+
+		tiny3d_SetPolygon(TINY3D_QUADS);
+
+		for (i = first; i < count; i++) {
+			if (i > first && cullQuad(x+i*4, y+i*4))
+				continue;
+
+			for (k = i*4; k < (i+1)*4; k++) {
+				tiny3d_VertexPos(x[k], y[k], z);
+				tiny3d_VertexColor(blendColor(rgba[k]));
+			}
+			_drawStats.Submitted++;
+		}
+
+		tiny3d_End();
+	}
+
+	//---------------------------------------------------------------------------
+	// Blend Functions
+	//---------------------------------------------------------------------------
+	void Mini::applyState() {
+		tiny3d_AlphaTest(_alphaEnabled, 0, TINY3D_ALPHA_FUNC_GEQUAL);
+		_blendState = -1;
+		setBlendState(blendState(), _alphaEnabled);
+		tiny3d_Project2D();
+	}
+
+	unsigned int Mini::blendState() {
+		if (!_premultiplied)
+			return _blendMode;
+
+		// Additive is normal blending with an alpha of 0 (see blendColor)
+		return BLEND_STATE_PREMULTIPLIED | (_blendMode == BLEND_MULTIPLY ? BLEND_MULTIPLY : BLEND_NORMAL);
+	}
+
+	void Mini::setBlendState(unsigned int state, int alphaEnabled) {
+		unsigned int src, dst;
+
+		if ((int)state == _blendState)
+			return;
+		_blendState = state;
+
+		switch (state) {
+			case BLEND_ADDITIVE:
+				src = TINY3D_BLEND_FUNC_SRC_RGB_SRC_ALPHA | TINY3D_BLEND_FUNC_SRC_ALPHA_ZERO;
+				dst = TINY3D_BLEND_FUNC_DST_RGB_ONE | TINY3D_BLEND_FUNC_DST_ALPHA_ONE;
+				break;
+			case BLEND_MULTIPLY:
+				src = TINY3D_BLEND_FUNC_SRC_RGB_DST_COLOR | TINY3D_BLEND_FUNC_SRC_ALPHA_ZERO;
+				dst = TINY3D_BLEND_FUNC_DST_RGB_ZERO | TINY3D_BLEND_FUNC_DST_ALPHA_ONE;
+				break;
+			case BLEND_STATE_PREMULTIPLIED | BLEND_NORMAL:
+				src = TINY3D_BLEND_FUNC_SRC_RGB_ONE | TINY3D_BLEND_FUNC_SRC_ALPHA_ONE;
+				dst = TINY3D_BLEND_FUNC_DST_RGB_ONE_MINUS_SRC_ALPHA | TINY3D_BLEND_FUNC_DST_ALPHA_ONE_MINUS_SRC_ALPHA;
+				break;
+			case BLEND_STATE_PREMULTIPLIED | BLEND_MULTIPLY:
+				src = TINY3D_BLEND_FUNC_SRC_RGB_DST_COLOR | TINY3D_BLEND_FUNC_SRC_ALPHA_ZERO;
+				dst = TINY3D_BLEND_FUNC_DST_RGB_ONE_MINUS_SRC_ALPHA | TINY3D_BLEND_FUNC_DST_ALPHA_ONE;
+				break;
+			default:
+				src = TINY3D_BLEND_FUNC_SRC_RGB_SRC_ALPHA | TINY3D_BLEND_FUNC_SRC_ALPHA_SRC_ALPHA;
+				dst = TINY3D_BLEND_FUNC_DST_RGB_ONE_MINUS_SRC_ALPHA | TINY3D_BLEND_FUNC_DST_ALPHA_ZERO;
+				break;
+		}
+
+		tiny3d_BlendFunc(alphaEnabled, (blend_src_func)src, (blend_dst_func)dst,
+							(blend_func)(TINY3D_BLEND_RGB_FUNC_ADD | TINY3D_BLEND_ALPHA_FUNC_ADD));
+	}
+
+	unsigned int Mini::blendColor(unsigned int rgba) {
+		unsigned int a = rgba & 0xFF, r, g, b;
+
+		if (!_premultiplied)
+			return rgba;
+
+		// Vertex colors are RGBA. Premultiply, then drop alpha for additive so the destination is kept
+		r = ((rgba >> 24) * a + 127) / 255;
+		g = (((rgba >> 16) & 0xFF) * a + 127) / 255;
+		b = (((rgba >> 8) & 0xFF) * a + 127) / 255;
+		return (r << 24) | (g << 16) | (b << 8) | (_blendMode == BLEND_ADDITIVE ? 0 : a);
+	}
+
+	//---------------------------------------------------------------------------
+	// Queue Functions
+	//---------------------------------------------------------------------------
+	void Mini::initCommand(DrawQueue::DrawCommand * command, DrawQueue::DrawCommandType type, float z) {
+		memset(command, 0, sizeof(DrawQueue::DrawCommand));
+		command->Type = type;
+		command->Blend = blendState();
+		command->View = _viewIndex;
+		command->Z = z;
+	}
+
+	void Mini::queueQuads(DrawQueue::DrawCommand * command, const float * x, const float * y, const float * u, const float * v, int count, const unsigned int * rgba, bool vertexColors) {
+		unsigned int colors[4];
+		int i, k, first;
+
+		// Find the first visible quad so that no command is pushed if every quad is culled
+		for (first = 0; first < count; first++)
+			if (!cullQuad(x+first*4, y+first*4))
+				break;
+		if (first == count)
+			return;
+
+		_drawQueue->Push(*command);
+		for (i = first; i < count; i++) {
+			if (i > first && cullQuad(x+i*4, y+i*4))
+				continue;
+
+			if (vertexColors) {
+				for (k = 0; k < 4; k++)
+					colors[k] = blendColor(rgba[i*4+k]);
+				_drawQueue->AddQuad(x+i*4, y+i*4, colors);
+			}
+			else
+				_drawQueue->AddQuad(x+i*4, y+i*4, u ? u+i*4 : NULL, v ? v+i*4 : NULL, blendColor(rgba ? rgba[i] : 0xFFFFFFFF));
+			_drawStats.Submitted++;
+		}
+	}
+
+	void Mini::submitQueue() {
+		if (!_drawQueue || !_drawQueue->Count())
+			return;
+
+		submit(_drawQueue, _alphaEnabled);
+
+		_drawQueue->Clear();
+		setBlendState(blendState(), _alphaEnabled);
+
+		// Restore the current space (and re-add its view to the now empty queue)
+		updateView();
+	}
+
+	void Mini::submit(DrawQueue * queue, int alphaEnabled) {
+		unsigned int i, k, j, boundTexture = 0;
+		int view = -1, wrap, boundWrap = TEXTWRAP_CLAMP;
+		const DrawQueue::DrawQuad * quads;
+		const MATRIX * matrix = NULL;
+
+		queue->Sort();
+
+		// Replayed draws are already culled and counted. Each uses the view it was recorded with.
+		// Only the queue is read so that the render thread can submit while the next frame is recorded
+		for (i = 0; i < queue->Count(); i++) {
+			const DrawQueue::DrawCommand& command = queue->Get(i);
+
+			if (i == 0 || command.View != view) {
+				view = command.View;
+				matrix = queue->GetView(view);
+			}
+
+			// Sorting groups draws by blend state then texture, so only set them when they change
+			setBlendState(command.Blend, alphaEnabled);
+
+			wrap = command.Repeat ? TEXTWRAP_REPEAT : TEXTWRAP_CLAMP;
+			if (command.TextureOff && (command.TextureOff != boundTexture || wrap != boundWrap)) {
+				boundTexture = command.TextureOff;
+				boundWrap = wrap;
+				tiny3d_SetTextureWrap(0, command.TextureOff, command.Width, command.Height, command.Pitch,
+					(text_format)command.ColorFormat, wrap, wrap, TEXTURE_LINEAR);
+			}
+
+			switch (command.Type) {
+				case DrawQueue::DRAW_COMMAND_TEXTURE:
+					drawSpriteRot(matrix, command.XAnchor, command.YAnchor, command.X, command.Y, command.Z, command.W, command.H,
+						command.U0, command.V0, command.U1, command.V1,
+						command.RGBA[0], command.RGBA[1], command.RGBA[2], command.RGBA[3], command.Angle);
+					break;
+				case DrawQueue::DRAW_COMMAND_RECTANGLE:
+					drawRectangle(matrix, command.XAnchor, command.YAnchor, command.X, command.Y, command.Z, command.W, command.H,
+						command.RGBA[0], command.RGBA[1], command.RGBA[2], command.RGBA[3], command.Angle);
+					break;
+				case DrawQueue::DRAW_COMMAND_TEXTURE_QUADS:
+				case DrawQueue::DRAW_COMMAND_RECTANGLE_QUADS:
+					quads = queue->GetQuads(command);
+					if (!quads)
+						break;
+
+					tiny3d_SetMatrixModelView((MATRIX*)matrix);
+					tiny3d_SetPolygon(TINY3D_QUADS);
+					for (k = 0; k < command.Count; k++) {
+						for (j = 0; j < 4; j++) {
+							tiny3d_VertexPos(quads[k].X[j], quads[k].Y[j], command.Z);
+							tiny3d_VertexColor(quads[k].RGBA[j]);
+							if (command.Type == DrawQueue::DRAW_COMMAND_TEXTURE_QUADS)
+								tiny3d_VertexTexture(quads[k].U[j], quads[k].V[j]);
+						}
+					}
+					tiny3d_End();
+					break;
+			}
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Culling Functions
+	//---------------------------------------------------------------------------
+	void Mini::updateView() {
+		_worldView = _drawSpace == DRAW_SPACE_WORLD && _camera;
+		_viewIndex = -1;
+
+		if (!_worldView) {
+			_viewMinX = _minW;
+			_viewMinY = _minH;
+			_viewMaxX = _maxW;
+			_viewMaxY = _maxH;
+			return;
+		}
+
+		// Tiny3D rotates opposite to RectangleF (see Image::Draw), so passing the angle as is rotates the world against the camera
+		_viewMatrix = MatrixTranslation(-_camera->Position.X, -_camera->Position.Y, 0.0f);
+		_viewMatrix = MatrixMultiply(_viewMatrix, MatrixRotationZ(degToRad(_camera->Rotation)));
+		_viewMatrix = MatrixMultiply(_viewMatrix, MatrixScale(_camera->Zoom, _camera->Zoom, 1.0f));
+		_viewMatrix = MatrixMultiply(_viewMatrix, MatrixTranslation(_camera->Origin.X, _camera->Origin.Y, 0.0f));
+
+		_camera->GetVisibleBounds(&_viewMinX, &_viewMinY, &_viewMaxX, &_viewMaxY);
+
+		// Queued draws reference the view that was active when they were recorded
+		if (_drawQueue)
+			_viewIndex = _drawQueue->AddView(_viewMatrix);
+	}
+
+	bool Mini::cullRectangle(float xAnchor, float yAnchor, float x, float y, float w, float h, float angle) {
+		float c = 1, s = 0, ex, ey, cx, cy, sx, sy;
+
+		if (!_cullEnabled) {
+			_drawStats.Submitted++;
+			return 0;
+		}
+
+		if (angle) {
+			angle = degToRad(angle);
+			c = cos(angle);
+			s = sin(angle);
+		}
+
+		// Half extents of the rotated rectangle's bounding box
+		ex = (fabs(c)*w + fabs(s)*h) / 2;
+		ey = (fabs(s)*w + fabs(c)*h) / 2;
+
+		// Center rotated around the anchor. The bounds cover either rotation direction so the test stays conservative
+		x -= xAnchor;
+		y -= yAnchor;
+		cx = xAnchor + c*x;
+		cy = yAnchor + c*y;
+		sx = fabs(s*y) + ex;
+		sy = fabs(s*x) + ey;
+
+		if ((cx + sx) < _viewMinX || (cx - sx) > _viewMaxX || (cy + sy) < _viewMinY || (cy - sy) > _viewMaxY) {
+			_drawStats.Culled++;
+			return 1;
+		}
+
+		_drawStats.Submitted++;
+		return 0;
+	}
+
+	bool Mini::cullQuad(const float * x, const float * y) {
+		float minX = x[0], maxX = x[0], minY = y[0], maxY = y[0];
+		int i;
+
+		if (!_cullEnabled)
+			return 0;
+
+		for (i = 1; i < 4; i++) {
+			if (x[i] < minX) minX = x[i];
+			if (x[i] > maxX) maxX = x[i];
+			if (y[i] < minY) minY = y[i];
+			if (y[i] > maxY) maxY = y[i];
+		}
+
+		if (maxX < _viewMinX || minX > _viewMaxX || maxY < _viewMinY || minY > _viewMaxY) {
+			_drawStats.Culled++;
+			return 1;
+		}
+
+		return 0;
+	}
+
+	void Mini::drawSpriteRot(const MATRIX * view, float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, float u0, float v0, float u1, float v1, u32 rgba0, u32 rgba1, u32 rgba2, u32 rgba3, float angle) {
 		MATRIX matrix;
 		dx/=2;
 		dy/=2;
@@ -362,6 +1265,8 @@ namespace Mini2D {
 		angle = degToRad(angle);
 		matrix = MatrixRotationZ(angle);
 		matrix = MatrixMultiply(matrix, MatrixTranslation(xAnchor, yAnchor, 0.0f));
+		if (view)
+			matrix = MatrixMultiply(matrix, *view);
 
 		// Translate relative to anchor point based on angle
 		x-=xAnchor;
@@ -374,19 +1279,19 @@ namespace Mini2D {
 
 		tiny3d_VertexPos(x-dx, y-dy, layer);
 		tiny3d_VertexColor(rgba0);
-		tiny3d_VertexTexture(0.0f, 0.0f);
+		tiny3d_VertexTexture(u0, v0);
 
 		tiny3d_VertexPos(x+dx, y-dy, layer);
 		tiny3d_VertexColor(rgba1);
-		tiny3d_VertexTexture(0.999999f, 0.0f);
+		tiny3d_VertexTexture(u1, v0);
 
 		tiny3d_VertexPos(x+dx, y+dy, layer);
 		tiny3d_VertexColor(rgba2);
-		tiny3d_VertexTexture(0.999999f, 0.999999f);
+		tiny3d_VertexTexture(u1, v1);
 
 		tiny3d_VertexPos(x-dx, y+dy, layer);
 		tiny3d_VertexColor(rgba3);
-		tiny3d_VertexTexture(0.0f, 0.999999f);
+		tiny3d_VertexTexture(u0, v1);
 
 		tiny3d_End();
 
@@ -396,4 +1301,10 @@ namespace Mini2D {
 
 	float degToRad(float d) { while(d>180){d-=360;}while(d<-180){d+=360;} return (d*3.14159f)/180.f; }
 
+	double timeMs() {
+		struct timeval tv;
+		gettimeofday(&tv, NULL);
+		return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+	}
+
 }
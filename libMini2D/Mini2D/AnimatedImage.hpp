@@ -0,0 +1,189 @@
+/*
+ * AnimatedImage.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_ANIMATEDIMAGE_HPP_
+#define MINI2D_ANIMATEDIMAGE_HPP_
+
+#include <vector>                                // std::vector<>
+
+#include <Mini2D/Image.hpp>                      // Image class
+#include <Mini2D/Units.hpp>                      // RectangleF
+
+namespace Mini2D {
+
+	class AnimatedImage;
+
+	class SpriteSheet {
+	public:
+		typedef struct _spriteFrame_t {
+			float X, Y, W, H;                    // Region of the sheet (pixels)
+			float Duration;                      // Time the frame is shown for (seconds)
+		} SpriteFrame;
+
+		// Constructors
+		SpriteSheet(Image * image);
+		virtual ~SpriteSheet();
+
+		/*
+		 * AddFrame:
+		 *		Adds a frame to the end of the sheet
+		 *
+		 * x, y, w, h:
+		 *		Region of the sheet (pixels)
+		 * duration:
+		 *		Time the frame is shown for (seconds)
+		 *
+		 * Return:
+		 *		Index of frame
+		 */
+		int AddFrame(float x, float y, float w, float h, float duration);
+
+		/*
+		 * AddFrames:
+		 *		Adds a grid of equally sized frames, left to right then top to bottom
+		 *
+		 * x, y:
+		 *		Top left of the first frame (pixels)
+		 * frameWidth, frameHeight:
+		 *		Size of each frame (pixels)
+		 * columns:
+		 *		Number of frames per row
+		 * count:
+		 *		Number of frames
+		 * duration:
+		 *		Time each frame is shown for (seconds)
+		 *
+		 * Return:
+		 *		Index of first frame. -1 if invalid
+		 */
+		int AddFrames(float x, float y, float frameWidth, float frameHeight, int columns, int count, float duration);
+
+		/*
+		 * Update:
+		 *		Advances every AnimatedImage created from this sheet
+		 *
+		 * deltaTime:
+		 *		Time since last frame
+		 */
+		void Update(float deltaTime);
+
+		/*
+		 * GetFrameCount:
+		 *		Returns the number of frames
+		 */
+		int GetFrameCount();
+
+		/*
+		 * GetFrame:
+		 *		Returns a frame. Null if index is out of range
+		 *
+		 * index:
+		 *		Index of frame
+		 */
+		const SpriteFrame * GetFrame(int index);
+
+		/*
+		 * GetImage:
+		 *		Returns the image the frames are drawn from
+		 */
+		Image * GetImage();
+
+	private:
+		friend class AnimatedImage;
+
+		Image * _image;                          // Sheet texture
+		std::vector<SpriteFrame> _frames;        // Frames
+		std::vector<AnimatedImage*> _instances;  // Every AnimatedImage using this sheet
+
+		// Track an AnimatedImage for Update()
+		void addInstance(AnimatedImage * instance);
+		// Stop tracking an AnimatedImage
+		void removeInstance(AnimatedImage * instance);
+	};
+
+	class AnimatedImage {
+	public:
+		typedef enum _animationMode_t {
+			ANIMATION_LOOP = 0,                  // Restart from the first frame after the last
+			ANIMATION_ONCE,                      // Stop on the last frame
+			ANIMATION_PING_PONG                  // Play forwards then backwards
+		} AnimationMode;
+
+		RectangleF DrawRegion;                   // Where to draw image to
+		float ZIndex;                            // Z coordinate (lower numbers are drawn over higher numbers)
+		AnimationMode Mode;                      // How the animation continues after the last frame
+		float Speed;                             // Playback rate (1 is normal speed)
+		bool Playing;                            // Whether Update advances the animation
+
+		// Constructors
+		AnimatedImage(SpriteSheet * sheet);
+		virtual ~AnimatedImage();
+
+		/*
+		 * SetFrames:
+		 *		Sets the range of sheet frames to play and restarts the animation from first
+		 *
+		 * first:
+		 *		Index of first frame
+		 * last:
+		 *		Index of last frame. If < 0, the last frame of the sheet
+		 */
+		void SetFrames(int first, int last = -1);
+
+		/*
+		 * SetFrame:
+		 *		Jumps to a frame
+		 *
+		 * index:
+		 *		Index of sheet frame
+		 */
+		void SetFrame(int index);
+
+		/*
+		 * GetFrame:
+		 *		Returns the index of the sheet frame being shown
+		 */
+		int GetFrame();
+
+		/*
+		 * Update:
+		 *		Advances the animation. Use SpriteSheet::Update to advance every instance of a sheet at once
+		 *
+		 * deltaTime:
+		 *		Time since last frame
+		 */
+		void Update(float deltaTime);
+
+		/*
+		 * Draw:
+		 * 		Draws the current frame onto the current frame
+		 *
+		 * rgba:
+		 *		Color
+		 */
+		void Draw(unsigned int rgba = 0xFFFFFFFF);
+
+	private:
+		friend class SpriteSheet;
+
+		SpriteSheet * _sheet;
+
+		int _first, _last;                       // Range of frames played (_last < 0 for the end of the sheet)
+		int _frame;                              // Current frame
+		int _direction;                          // 1 or -1 (ANIMATION_PING_PONG)
+		float _time;                             // Time spent on current frame
+		int _index;                              // Index in _sheet's instance list
+
+		// Advance by deltaTime using the sheet's frames
+		void advance(const SpriteSheet::SpriteFrame * frames, int frameCount, float deltaTime);
+		// Move to the next frame. Returns 0 if the animation has finished
+		bool step(int first, int last);
+	};
+
+}
+
+#endif /* MINI2D_ANIMATEDIMAGE_HPP_ */
@@ -0,0 +1,60 @@
+/*
+ * Camera.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_CAMERA_HPP_
+#define MINI2D_CAMERA_HPP_
+
+#include <Mini2D/Mini.hpp>                       // Mini class
+#include <Mini2D/Units.hpp>                      // Vector2
+
+namespace Mini2D {
+
+	class Camera {
+	public:
+		Vector2 Position;                        // World point the camera looks at
+		Vector2 Origin;                          // Screen point Position is drawn at (default is the center of the screen)
+		float Zoom;                              // Scale of the world (1 is unscaled)
+		float Rotation;                          // Angle of rotation of the camera (degrees)
+
+		// Constructors
+		Camera(Mini * mini);
+		virtual ~Camera();
+
+		/*
+		 * WorldToScreen:
+		 *		Converts a world coordinate into a screen coordinate
+		 *
+		 * world:
+		 *		World coordinate
+		 */
+		Vector2 WorldToScreen(const Vector2& world);
+
+		/*
+		 * ScreenToWorld:
+		 *		Converts a screen coordinate into a world coordinate
+		 *
+		 * screen:
+		 *		Screen coordinate
+		 */
+		Vector2 ScreenToWorld(const Vector2& screen);
+
+		/*
+		 * GetVisibleBounds:
+		 *		Gets the axis aligned bounds of the region of the world that is visible on screen
+		 *
+		 * minX, minY, maxX, maxY [OUT]:
+		 *		Bounds
+		 */
+		void GetVisibleBounds(float * minX, float * minY, float * maxX, float * maxY);
+
+	private:
+		Mini * _mini;
+	};
+
+}
+
+#endif /* MINI2D_CAMERA_HPP_ */
@@ -0,0 +1,234 @@
+/*
+ * Collision.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_COLLISION_HPP_
+#define MINI2D_COLLISION_HPP_
+
+#include <vector>                                // std::vector<>
+
+#include <Mini2D/Units.hpp>                      // CircleF, RectangleF, Vector2
+
+namespace Mini2D {
+
+	class Collision {
+	public:
+		typedef enum _colliderType_t {
+			COLLIDER_NONE = 0,
+			COLLIDER_CIRCLE,
+			COLLIDER_RECTANGLE,
+			COLLIDER_POLYGON
+		} ColliderType;
+
+		typedef struct _collisionPair_t {
+			int A;                               // Id of first body
+			int B;                               // Id of second body
+			Vector2 Normal;                      // Contact normal, pointing from body A toward body B
+		} CollisionPair;
+
+		// Constructors
+		Collision(float cellSize, unsigned int maxBodies);
+		virtual ~Collision();
+
+		/*
+		 * Add:
+		 *		Adds a body to the broadphase. The body is not copied and must outlive this object or be removed
+		 *
+		 * circle/rectangle:
+		 *		Shape of body
+		 * polygon:
+		 *		Array of points of a convex polygon
+		 * polyCount:
+		 *		Number of points in polygon
+		 *
+		 * Return:
+		 *		Id of body. -1 if invalid
+		 */
+		int Add(CircleF * circle);
+		int Add(RectangleF * rectangle);
+		int Add(Vector2 * polygon[], int polyCount);
+
+		/*
+		 * Remove:
+		 *		Removes a body from the broadphase. Its id may be reused by the next Add
+		 *
+		 * id:
+		 *		Id of body
+		 */
+		void Remove(int id);
+
+		/*
+		 * Clear:
+		 *		Removes all bodies
+		 */
+		void Clear();
+
+		/*
+		 * Update:
+		 *		Rebuilds the spatial hash from the current location of every body and finds all colliding pairs
+		 *
+		 * Return:
+		 *		Number of colliding pairs
+		 */
+		int Update();
+
+		/*
+		 * GetPairs:
+		 *		Returns the colliding pairs found by the last Update()
+		 */
+		const std::vector<CollisionPair>& GetPairs();
+
+		/*
+		 * Query:
+		 *		Finds every body whose bounds overlap the given axis aligned region. Uses the hash built by the last Update()
+		 *
+		 * minX, minY, maxX, maxY:
+		 *		Region to test
+		 * results [OUT]:
+		 *		Ids of overlapping bodies (appended)
+		 *
+		 * Return:
+		 *		Number of ids appended
+		 */
+		int Query(float minX, float minY, float maxX, float maxY, std::vector<int>& results);
+
+		/*
+		 * GetType:
+		 *		Returns the collider type of a body
+		 */
+		ColliderType GetType(int id);
+
+		/*
+		 * Intersect:
+		 *		Determines if two circles intersect
+		 *
+		 * a:
+		 *		First circle
+		 * b:
+		 *		Second circle
+		 * normal [OUT]:
+		 *		Normalized vector from the center of a to the center of b (can be null)
+		 *
+		 * Return:
+		 *		1 if they intersect. 0 if not.
+		 */
+		static bool Intersect(CircleF * a, CircleF * b, Vector2 * normal);
+
+		/*
+		 * Intersect:
+		 *		Determines if a circle intersects a (rotated) rectangle, including when it lies wholly inside
+		 *
+		 * circle:
+		 *		Circle to compare with
+		 * rectangle:
+		 *		Rectangle to compare with
+		 * normal [OUT]:
+		 *		The resulting normal of the intersected edges, pointing from the circle into the rectangle (can be null)
+		 *
+		 * Return:
+		 *		1 if they intersect. 0 if not.
+		 */
+		static bool Intersect(CircleF * circle, RectangleF * rectangle, Vector2 * normal);
+
+		/*
+		 * Intersect:
+		 *		Determines if a circle intersects a convex polygon, including when it lies wholly inside.
+		 *		The normal is the sum of the perpendiculars of every edge within the radius, normalized.
+		 *		A circle inside the polygon that touches no edge gets the perpendicular of the closest edge
+		 *
+		 * circle:
+		 *		Circle to compare with
+		 * polygon:
+		 *		Array of points
+		 * polyCount:
+		 *		Number of points in polygon
+		 * normal [OUT]:
+		 *		The resulting normal of the intersected edges, pointing from the circle into the polygon (can be null)
+		 * points [OUT]:
+		 *		The number of edges of polygon within the circle (can be null)
+		 *
+		 * Return:
+		 *		1 if they intersect. 0 if not.
+		 */
+		static bool Intersect(CircleF * circle, Vector2 * polygon[], int polyCount, Vector2 * normal, int * points);
+
+		/*
+		 * Intersect:
+		 *		Determines if two convex polygons intersect (separating axis test)
+		 *
+		 * a:
+		 *		Array of points of first polygon
+		 * aCount:
+		 *		Number of points in a
+		 * b:
+		 *		Array of points of second polygon
+		 * bCount:
+		 *		Number of points in b
+		 * normal [OUT]:
+		 *		Axis of least penetration, pointing from a to b (can be null)
+		 *
+		 * Return:
+		 *		1 if they intersect. 0 if not.
+		 */
+		static bool Intersect(Vector2 * a[], int aCount, Vector2 * b[], int bCount, Vector2 * normal);
+
+		/*
+		 * Intersect:
+		 *		Determines if two (rotated) rectangles intersect (separating axis test)
+		 *
+		 * a:
+		 *		First rectangle
+		 * b:
+		 *		Second rectangle
+		 * normal [OUT]:
+		 *		Axis of least penetration, pointing from a to b (can be null)
+		 *
+		 * Return:
+		 *		1 if they intersect. 0 if not.
+		 */
+		static bool Intersect(RectangleF * a, RectangleF * b, Vector2 * normal);
+
+	private:
+		typedef struct _collisionBody_t {
+			ColliderType type;                   // Type of shape (COLLIDER_NONE if unused)
+			CircleF * circle;                    // Circle shape
+			RectangleF * rectangle;              // Rectangle shape
+			Vector2 ** polygon;                  // Polygon shape
+			int polyCount;                       // Number of points in polygon
+			float minX, minY, maxX, maxY;        // Bounds from last Update()
+		} CollisionBody;
+
+		float _cellSize;                         // Width and height of a grid cell
+		float _invCellSize;                      // 1/_cellSize
+		unsigned int _tableMask;                 // Number of hash buckets - 1
+
+		std::vector<CollisionBody> _bodies;      // Bodies indexed by id
+		std::vector<int> _freeIds;               // Ids of removed bodies
+		std::vector<int> _bucketStart;           // Offset of each bucket in _entries (size is buckets + 1)
+		std::vector<int> _bucketCursor;          // Write position of each bucket while building
+		std::vector<int> _bucketStamp;           // Last body inserted into each bucket while building
+		std::vector<int> _entries;               // Body ids sorted by bucket
+		std::vector<int> _queryStamp;            // Last query that reported each body
+		int _queryCount;                         // Number of queries run
+		std::vector<CollisionPair> _pairs;       // Pairs found by last Update()
+
+		// Add body to the first free id
+		int addBody(const CollisionBody& body);
+		// Calculate the bounds of a body
+		void updateBounds(CollisionBody * body);
+		// Get the grid cell of a coordinate
+		int cell(float v);
+		// Hash a grid cell to a bucket
+		unsigned int hash(int x, int y);
+		// Insert every body into the hash
+		void buildHash();
+		// Run the narrowphase test between two bodies
+		bool narrowphase(CollisionBody * a, CollisionBody * b, Vector2 * normal);
+	};
+
+}
+
+#endif /* MINI2D_COLLISION_HPP_ */
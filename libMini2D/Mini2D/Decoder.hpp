@@ -0,0 +1,79 @@
+/*
+ * Decoder.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_DECODER_HPP_
+#define MINI2D_DECODER_HPP_
+
+namespace Mini2D {
+
+	/*
+	 * Decoder:
+	 *		PNG/JPG decoder built on libpng and libjpeg instead of the PS3 pngdec/jpgdec modules, so images can be
+	 *		decoded, benchmarked and fuzzed on any platform. Only built when MINI2D_PORTABLE_DECODER is defined
+	 *		(make PORTABLE_DECODER=1), in which case Image uses it for every PNG/JPG load
+	 */
+	class Decoder {
+	public:
+		typedef enum _decoderType_t {
+			DECODER_TYPE_PNG = 0,
+			DECODER_TYPE_JPG
+		} DecoderType;
+
+		/*
+		 * GetSize:
+		 *		Reads the size of an image without decoding it
+		 *
+		 * buffer:
+		 *		Buffer containing image
+		 * size:
+		 *		Size of buffer
+		 * type:
+		 *		Type of image the buffer contains
+		 * width [OUT]:
+		 *		Width of image
+		 * height [OUT]:
+		 *		Height of image
+		 *
+		 * Return:
+		 *		1 if the header is valid
+		 */
+		static bool GetSize(const void * buffer, unsigned int size, DecoderType type, int * width, int * height);
+
+		/*
+		 * Decode:
+		 *		Decodes an image straight into an ARGB buffer, one row at a time. argb is only written to, never read, so it can be the texture heap
+		 *
+		 * buffer:
+		 *		Buffer containing image
+		 * size:
+		 *		Size of buffer
+		 * type:
+		 *		Type of image the buffer contains
+		 * argb [OUT]:
+		 *		Array of ARGB pixels. Must hold pitch * height bytes
+		 * pitch:
+		 *		Number of bytes per row of argb (at least width * 4)
+		 * premultiply:
+		 *		Whether to multiply the color channels by alpha (done on each row before it is written)
+		 *
+		 * Return:
+		 *		1 if decoded
+		 */
+		static bool Decode(const void * buffer, unsigned int size, DecoderType type, unsigned int * argb, int pitch, bool premultiply = 0);
+
+	private:
+		// Decode PNG. If argb is null only the size is read
+		static bool decodePNG(const void * buffer, unsigned int size, int * width, int * height, unsigned int * argb, int pitch, bool premultiply);
+		// Decode JPG. If argb is null only the size is read. JPGs are opaque so they are never premultiplied
+		static bool decodeJPG(const void * buffer, unsigned int size, int * width, int * height, unsigned int * argb, int pitch);
+		// Write a decoded RGBA row to argb, premultiplying it in place first if asked
+		static void writeRow(unsigned char * rgba, unsigned int * argb, int width, bool premultiply);
+	};
+
+}
+
+#endif /* MINI2D_DECODER_HPP_ */
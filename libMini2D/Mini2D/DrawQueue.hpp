@@ -0,0 +1,169 @@
+/*
+ * DrawQueue.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_DRAWQUEUE_HPP_
+#define MINI2D_DRAWQUEUE_HPP_
+
+#include <vector>                                // std::vector<>
+
+#include <tiny3d.h>                              // MATRIX
+
+namespace Mini2D {
+
+	class DrawQueue {
+	public:
+		typedef enum _drawCommandType_t {
+			DRAW_COMMAND_TEXTURE = 0,
+			DRAW_COMMAND_RECTANGLE,
+			DRAW_COMMAND_TEXTURE_QUADS,
+			DRAW_COMMAND_RECTANGLE_QUADS
+		} DrawCommandType;
+
+		typedef struct _drawCommand_t {
+			DrawCommandType Type;                // Type of draw
+			unsigned int Blend;                  // Blend state. Draws sharing one are grouped together within a layer
+			int View;                            // Index of view matrix (see AddView). -1 for screen space
+			unsigned int TextureOff;             // RSX offset to texture (0 if untextured)
+			int Pitch, Width, Height;            // Texture dimensions
+			unsigned int ColorFormat;            // Tiny3D pixel format
+			bool Repeat;                         // Whether texture coordinates wrap instead of clamp
+			float XAnchor, YAnchor;              // Point to rotate around
+			float X, Y, Z;                       // Center and layer
+			float W, H;                          // Size
+			float Angle;                         // Angle of rotation (degrees)
+			float U0, V0, U1, V1;                // Texture coordinates of the top left and bottom right corners
+			unsigned int RGBA[4];                // Corner colors (TopLeft, TopRight, BottomRight, BottomLeft)
+			unsigned int First;                  // Index of first quad (quad commands only)
+			unsigned int Count;                  // Number of quads (quad commands only)
+		} DrawCommand;
+
+		typedef struct _drawQuad_t {
+			float X[4], Y[4];                    // Vertices in draw order (TopLeft, TopRight, BottomRight, BottomLeft)
+			float U[4], V[4];                    // Texture coordinates
+			unsigned int RGBA[4];                // Vertex colors
+		} DrawQuad;
+
+		// Constructors
+		DrawQueue(unsigned int reserve = 1024);
+		virtual ~DrawQueue();
+
+		/*
+		 * Clear:
+		 *		Removes every command, quad and view. Memory is kept for the next frame
+		 */
+		void Clear();
+
+		/*
+		 * Push:
+		 *		Adds a command to the end of the queue
+		 *
+		 * command:
+		 *		Command to add. First and Count are set by AddQuad
+		 */
+		void Push(const DrawCommand& command);
+
+		/*
+		 * AddQuad:
+		 *		Appends a quad to the last pushed command, which must be a quad command
+		 *
+		 * x:
+		 *		Array of 4 X coordinates
+		 * y:
+		 *		Array of 4 Y coordinates
+		 * u:
+		 *		Array of 4 U texture coordinates. If null the entire texture is mapped to the quad
+		 * v:
+		 *		Array of 4 V texture coordinates. If null the entire texture is mapped to the quad
+		 * rgba:
+		 *		Color
+		 */
+		void AddQuad(const float * x, const float * y, const float * u, const float * v, unsigned int rgba);
+
+		/*
+		 * AddQuad:
+		 *		Appends an untextured quad with a color per vertex to the last pushed command, which must be a quad command
+		 *
+		 * x:
+		 *		Array of 4 X coordinates
+		 * y:
+		 *		Array of 4 Y coordinates
+		 * rgba:
+		 *		Array of 4 colors
+		 */
+		void AddQuad(const float * x, const float * y, const unsigned int * rgba);
+
+		/*
+		 * AddView:
+		 *		Stores a view matrix for commands to reference
+		 *
+		 * view:
+		 *		View matrix
+		 *
+		 * Return:
+		 *		Index of view
+		 */
+		int AddView(const MATRIX& view);
+
+		/*
+		 * Sort:
+		 *		Orders the commands back to front by layer (higher Z first), then by blend state and texture.
+		 *		The sort is stable, so draws sharing all three keep the order they were pushed in.
+		 *		Untextured draws come before textured draws of the same layer
+		 */
+		void Sort();
+
+		/*
+		 * Count:
+		 *		Returns the number of commands
+		 */
+		unsigned int Count();
+
+		/*
+		 * Get:
+		 *		Returns a command. After Sort() commands are returned in sorted order
+		 *
+		 * index:
+		 *		Index of command
+		 */
+		const DrawCommand& Get(unsigned int index);
+
+		/*
+		 * GetQuads:
+		 *		Returns the quads of a quad command
+		 *
+		 * command:
+		 *		Quad command
+		 */
+		const DrawQuad * GetQuads(const DrawCommand& command);
+
+		/*
+		 * GetView:
+		 *		Returns a view matrix added by AddView
+		 *
+		 * index:
+		 *		Index of view
+		 */
+		const MATRIX * GetView(int index);
+
+	private:
+		std::vector<DrawCommand> _commands;      // Commands in push order
+		std::vector<DrawQuad> _quads;            // Quads of every quad command
+		std::vector<MATRIX> _views;              // View matrices
+
+		std::vector<unsigned long long> _keys;   // Sort keys (ping)
+		std::vector<unsigned long long> _keysTmp;// Sort keys (pong)
+		std::vector<unsigned int> _order;        // Command indices in sorted order (ping)
+		std::vector<unsigned int> _orderTmp;     // Command indices (pong)
+		bool _sorted;                            // Whether _order is valid
+
+		// Build the sort key of a command
+		static unsigned long long key(const DrawCommand& command);
+	};
+
+}
+
+#endif /* MINI2D_DRAWQUEUE_HPP_ */
@@ -9,10 +9,18 @@
 #define MINI2D_EMITTER_HPP_
 
 #include <vector>                                // std::vector<>
+#include <utility>                               // std::pair<>
 
 #include <Mini2D/Mini.hpp>                       // Mini class
 #include <Mini2D/Image.hpp>                      // Image class
 #include <Mini2D/Units.hpp>                      // RectangleF, Vector2
+#include <Mini2D/JobSystem.hpp>                  // Parallel chunk updates
+
+#define PARTICLE_CHUNK      1024                 // Particles per job. A chunk's state and vertices fit in an SPU's local store
+#define EMITTER_CURVE_SIZE  32                   // Entries in each lifetime curve
+#define EMITTER_CLOCK_WRAP  256                  // Seconds before ballistic birth times are rebased to keep float precision
+#define EMITTER_MAX_PARTICLES 0x100000           // Largest maxParticles an emitter accepts. Larger emitters get no particles
+#define EMITTER_JOB_COLLIDERS 32                 // Colliders a chunk can narrow its tests to. Past this every collider is tested
 
 namespace Mini2D {
 
@@ -25,6 +33,63 @@ namespace Mini2D {
 			EMITTER_PAUSED
 		} EmitterStatus;
 
+		typedef struct _emitterAttractor_t {
+			float X, Y;                          // Location
+			float Strength;                      // Acceleration toward the location (pixels per second squared). Negative repels
+			float Radius;                        // Distance the attractor reaches. 0 reaches everywhere
+		} EmitterAttractor;
+
+		/*
+		 * ParticleCollider:
+		 *		A collider's shape for the current update, flattened from its RectangleF or CircleF
+		 */
+		typedef struct _particleCollider_t {
+			float MinX, MinY, MaxX, MaxY;        // Bounds, tested before the shape
+			float X, Y;                          // Center
+			float AxisX, AxisY;                  // Direction of a rectangle's width (unit length)
+			float HalfW, HalfH;                  // Half the size of a rectangle
+			float Radius;                        // Radius of a circle. 0 for rectangles
+		} ParticleCollider;
+
+		/*
+		 * ParticleJob:
+		 *		One chunk of an emitter's particles. Arrays point into the emitter's 16 byte aligned
+		 *		structure of arrays, so a chunk can be moved with DMA and updated without the emitter
+		 */
+		typedef struct _particleJob_t {
+			float * X, * Y;                      // Centers
+			float * VelocityX, * VelocityY;      // Velocities (pixels per second)
+			float * Angle, * AngleVelocity;      // Rotation and spin (degrees, degrees per second)
+			float * TTL;                         // Remaining life (seconds)
+			float * Life;                        // Life at spawn (seconds)
+			float * W, * H;                      // Sizes
+			unsigned int * RGBA;                 // Colors
+			const float * Birth;                 // Spawn times. When set, X, Y, Velocity and Angle are spawn state and are only read
+			int Count;                           // Number of particles
+			float DeltaTime;                     // Time to advance by (0 when paused)
+			float Time;                          // Emitter clock Birth is measured against (seconds)
+			float ClipMinX, ClipMinY;            // Region particles must overlap to be drawn
+			float ClipMaxX, ClipMaxY;
+
+			float GravityX, GravityY;            // Acceleration (pixels per second squared)
+			float DragFactor;                    // Velocity multiplier for this step
+			const EmitterAttractor * Attractors; // Attractors (read only)
+			int AttractorCount;                  // Number of attractors
+			const float * ColorCurve;            // RGBA multipliers over normalized life (EMITTER_CURVE_SIZE*4). Null if unused
+			const float * AlphaCurve;            // Alpha multipliers over normalized life (EMITTER_CURVE_SIZE). Null if unused
+			const float * SizeCurve;             // Size multipliers over normalized life (EMITTER_CURVE_SIZE). Null if unused
+			const ParticleCollider * Colliders;  // Colliders (read only)
+			int ColliderCount;                   // Number of colliders
+			float Restitution;                   // Fraction of speed into a collider kept after bouncing
+
+			float * CornersX, * CornersY;        // Output: 4 vertices per visible particle (TopLeft, TopRight, BottomRight, BottomLeft)
+			unsigned int * Colors;               // Output: color of each visible particle
+			int * Dead;                          // Output: chunk index of each particle that died this step
+			int DeadCount;                       // Output: number of particles that died this step
+			int Visible;                         // Output: number of visible particles
+			int Alive;                           // Output: number of particles that were alive
+		} ParticleJob;
+
 		Vector2 RangeVelocityTheta;               // Minimum and maximum angle of velocity
 		Vector2 RangeVelocity;                    // Minimum and maximum speed
 		Vector2 RangeStartX;                      // Minimum and maximum X offset from emission location (locX + (X*randomNumber))
@@ -37,14 +102,21 @@ namespace Mini2D {
 		Vector2 RangeColorGreen;                  // Minimum and maximum green
 		Vector2 RangeColorBlue;                   // Minimum and maximum blue
 		Vector2 RangeColorAlpha;                  // Minimum and maximum alpha
-		RectangleF Clip;                          // Particle draw region. Any particles outside this box will not be drawn
+		RectangleF Clip;                          // Particle draw region. Any particles entirely outside this box will not be drawn
+		Vector2 Gravity;                          // Acceleration applied to every particle (pixels per second squared)
+		float Drag;                               // Fraction of velocity lost per second (exponential)
+		std::vector<EmitterAttractor> Attractors; // Points that pull (or push) particles
+		float Restitution;                        // Fraction of speed into a collider kept after bouncing (0 to 1)
 
 		float ZIndex;                             // Z coordinate
+		Mini::BlendMode Blend;                    // Blend mode particles are drawn with
 		unsigned int MinParticles;                // Minimum number of particles
-		bool Revive;                              // If particle dies before timeToLive hits 0, restart particle
+		float EmissionRate;                       // Particles spawned per second. 0 spawns between MinParticles and max at Start
+		bool Revive;                              // If particle dies before timeToLive hits 0, restart particle (ignored with EmissionRate)
 		bool SkipExplosion;                       // Skip initial explosion of particles (pair with revive)
+		bool Ballistic;                           // Move particles in closed form from spawn (velocity, spin and Gravity only). Ignores Drag, Attractors and colliders. Read by Start; changes apply on the next Start
 
-		Image * ParticleImage;                    // Optional image to draw particles with. Otherwise RGBA will be used
+		Image * ParticleImage;                    // Optional image to draw particles with (its DrawRegion is not used). Otherwise RGBA will be used
 
 
 		// Constructors
@@ -67,21 +139,131 @@ namespace Mini2D {
 		 */
 		bool Start(Vector2 location, float timeToLive = 0);
 
+		/*
+		 * Update:
+		 *		Starts advancing the particles on Mini's job system and returns without waiting.
+		 *		Updating every emitter before drawing any lets their updates run in parallel
+		 *
+		 * deltaTime:
+		 *		Time since last frame
+		 */
+		void Update(float deltaTime);
+
 		/*
 		 * Draw:
-		 *		Draws particles
+		 *		Waits for the last Update and draws particles. Given deltaTime, updates first
 		 *
 		 * deltaTime:
 		 *		Time since last frame
 		 */
+		void Draw();
 		void Draw(float deltaTime);
 
+		/*
+		 * UpdateJob:
+		 *		Advances a chunk of particles that were alive, and writes the vertices and colors of the ones that overlap the clip region.
+		 *		Only reads and writes the job's arrays. With Birth set, positions are evaluated at Time from the spawn state instead,
+		 *		so the state is only written when a particle dies.
+		 *		Gravity, drag and attractors are applied four particles at a time with AltiVec.
+		 *		Colliders outside the chunk's bounds are rejected, then the rest are tested four particles at a time.
+		 *		Only the end of each step is tested, so particles fast enough to cross a collider in one step pass through it
+		 *
+		 * job:
+		 *		ParticleJob to run
+		 */
+		static void UpdateJob(void * job);
+
+		/*
+		 * UpdateJobs:
+		 *		Runs a range of ParticleJobs with UpdateJob. Update forks its jobs onto Mini's JobSystem with it, but jobs share
+		 *		nothing, so any scheduler that splits a range (or a loop on the caller) can run the same jobs
+		 *
+		 * jobs:
+		 *		Array of ParticleJobs
+		 * start:
+		 *		First job to run
+		 * end:
+		 *		One past the last job to run
+		 */
+		static void UpdateJobs(void * jobs, int start, int end);
+
+		/*
+		 * SetColorCurve:
+		 *		Multiplies each particle's spawn color by a gradient over its life. Keys are spread evenly from birth to death
+		 *
+		 * rgba:
+		 *		Array of key colors. Null removes the curve
+		 * count:
+		 *		Number of keys
+		 */
+		void SetColorCurve(const unsigned int * rgba, int count);
+
+		/*
+		 * SetAlphaCurve:
+		 *		Multiplies each particle's alpha by a curve over its life. Keys are spread evenly from birth to death
+		 *
+		 * alpha:
+		 *		Array of key multipliers (0 to 1). Null removes the curve
+		 * count:
+		 *		Number of keys
+		 */
+		void SetAlphaCurve(const float * alpha, int count);
+
+		/*
+		 * SetSizeCurve:
+		 *		Scales each particle's spawn size by a curve over its life. Keys are spread evenly from birth to death
+		 *
+		 * scale:
+		 *		Array of key scales. Null removes the curve
+		 * count:
+		 *		Number of keys
+		 */
+		void SetSizeCurve(const float * scale, int count);
+
+		/*
+		 * AddCollider:
+		 *		Makes particles bounce off a rectangle or circle. Particles collide at their centers.
+		 *		The shape is read at every Update, so it may move. It must outlive the emitter or be removed with ClearColliders.
+		 *		There is no swept test: a particle that moves farther than the shape's thickness in one Update can tunnel through it
+		 *
+		 * rectangle:
+		 *		Rectangle to collide with (rotation and anchor are used)
+		 * circle:
+		 *		Circle to collide with
+		 */
+		void AddCollider(RectangleF * rectangle);
+		void AddCollider(CircleF * circle);
+
+		/*
+		 * ClearColliders:
+		 *		Removes every collider
+		 */
+		void ClearColliders();
+
 		/*
 		 * Status:
 		 *		Gets the status of the emitter
 		 */
 		EmitterStatus Status();
 
+		/*
+		 * GetLiveCount:
+		 *		Returns the number of living particles
+		 */
+		int GetLiveCount();
+
+		/*
+		 * GetVisibleCount:
+		 *		Returns the number of particles drawn by the last Draw
+		 */
+		int GetVisibleCount();
+
+		/*
+		 * GetMaxParticles:
+		 *		Returns the number of particles the emitter has room for
+		 */
+		int GetMaxParticles();
+
 		/*
 		 * Pause the particles (but still draw them)
 		 */
@@ -98,15 +280,11 @@ namespace Mini2D {
 		void Stop();
 
 	private:
-		typedef struct _emitterParticle_t {
-			RectangleF rect;
-			Vector2 velocity;
-			float angleVelocity;
+		friend class EmitterManager;
 
-			float TTL;
-			unsigned int RGBA;
-			bool spawn;
-		} EmitterParticle;
+		// Not copyable: the particle arrays are owned
+		Emitter(const Emitter&);
+		Emitter& operator=(const Emitter&);
 
 		Mini * _mini;
 
@@ -114,16 +292,69 @@ namespace Mini2D {
 		bool _loop;                               // Whether or not to continuously draw particles
 
 		int _maxP;                                // Maximum number of particles
-		int _activeP;                             // Current number of particles
+		int _activeP;                             // Number of particle slots in use (dead slots included)
+		int _live;                                // Number of living particles
+		bool _running;                            // Whether Start was called and the emitter has not stopped
+		bool _ballistic;                          // Ballistic as of the last Start
+		float _emitAccumulator;                   // Fraction of a particle owed by EmissionRate
+		float _rateScale;                         // Multiplier of EmissionRate set by an EmitterManager
+		int _capacity;                            // Size of each particle array (_maxP rounded up to 4)
 
 		float _timeLeft;                          // Number of seconds before draw is finished
 
 		Vector2 _startLocation;                   // Start location for the given emission session
 
-		std::vector<EmitterParticle> _particles;  // Particle collection
+		// Particle state, one array per field (structure of arrays). The first _activeP are in use
+		float * _x, * _y;                         // Centers
+		float * _vx, * _vy;                       // Velocities
+		float * _angle, * _spin;                  // Rotations and angular velocities
+		float * _ttl;                             // Remaining lives
+		float * _life;                            // Lives at spawn
+		float * _w, * _h;                         // Sizes
+		unsigned int * _rgba;                     // Colors
+		float * _birth;                           // Values of _time at spawn
+		float _time;                              // Seconds the particles have been updated since Start (rebased by EMITTER_CLOCK_WRAP)
+
+		float * _cornersX, * _cornersY;           // Vertices of visible particles (4 per particle)
+		unsigned int * _colors;                   // Colors of visible particles
+		int * _dead;                              // Indices of particles that died in the last update (per chunk)
+		int * _free;                              // Ring of dead slots that spawns reuse
+		int _freeHead, _freeCount;                // Oldest entry and number of entries in _free
+
+		float _colorCurve[EMITTER_CURVE_SIZE*4];  // RGBA multipliers over life
+		float _alphaCurve[EMITTER_CURVE_SIZE];    // Alpha multipliers over life
+		float _sizeCurve[EMITTER_CURVE_SIZE];     // Size multipliers over life
+		bool _useColorCurve, _useAlphaCurve, _useSizeCurve;
+
+		std::vector<RectangleF*> _rectangleColliders; // Rectangles particles bounce off
+		std::vector<CircleF*> _circleColliders;   // Circles particles bounce off
+		std::vector<ParticleCollider> _colliders; // Shapes of every collider at the last Update
+
+		std::vector<ParticleJob> _jobs;           // One job per chunk
+		std::vector<std::pair<float, int> > _scores; // Scratch (score, index) of each living particle for cull
+		JobSystem::JobHandle _pending;            // Jobs of the last Update
+		bool _updated;                            // Whether Update ran since the last Draw
+		float _deltaTime;                         // deltaTime of the last Update
+		int _visible;                             // Number of particles in the vertex stream
 
-		// Create particle
-		void createParticle(Vector2 location);
+		// Fill one job per chunk that advances by deltaTime
+		void buildJobs(float deltaTime);
+		// Resample count keys of width channels into a table of EMITTER_CURVE_SIZE entries
+		static void resampleCurve(const float * keys, int count, int channels, float * table);
+		// Entry of a lifetime curve for remaining life ttl of life
+		static int curveIndex(float ttl, float life);
+		// Apply gravity, drag and attractors to a job's living particles and move them. bounds gets minX, minY, maxX, maxY of the new positions
+		static void integrateJob(ParticleJob * job, float * bounds);
+		// Push a job's living particles out of the colliders they entered and bounce them. Only colliders overlapping bounds are tested
+		static void collideJob(ParticleJob * job, const float * bounds);
+		// Revive or free the particles that died in the last jobs, then spawn by EmissionRate
+		void emit(float deltaTime, bool revive);
+		// Kill the count living particles with the lowest score (size, or closeness to focus). Returns the number killed
+		int cull(int count, bool distant, Vector2 focus);
+		// Wait for the jobs of the last Update
+		void join();
+		// Create particle at index
+		void createParticle(int index, Vector2 location);
 	};
 
 }
@@ -0,0 +1,126 @@
+/*
+ * EmitterManager.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_EMITTERMANAGER_HPP_
+#define MINI2D_EMITTERMANAGER_HPP_
+
+#include <vector>                                // std::vector<>
+
+#include <Mini2D/Mini.hpp>                       // Mini class
+#include <Mini2D/Emitter.hpp>                    // Emitter class
+#include <Mini2D/Units.hpp>                      // Vector2
+
+namespace Mini2D {
+
+	/*
+	 * EmitterManager:
+	 *		Owns a set of emitters, updates them in one pass and keeps their combined particle count within a budget
+	 */
+	class EmitterManager {
+	public:
+		typedef enum _cullMode_t {
+			CULL_SMALLEST = 0,                   // Kill the particles with the smallest area first
+			CULL_DISTANT                         // Kill the particles furthest from Focus first
+		} CullMode;
+
+		typedef struct _emitterCost_t {
+			int Live;                            // Living particles after the last Draw
+			int Visible;                         // Particles drawn by the last Draw
+			int Culled;                          // Particles killed by the last Draw to stay within budget
+			float RateScale;                     // Multiplier applied to the emitter's EmissionRate
+			float Time;                          // Time spent in the emitter's Update and Draw on the calling thread (ms)
+		} EmitterCost;
+
+		unsigned int Budget;                     // Most living particles across every emitter. 0 is unlimited
+		CullMode Cull;                           // Which particles are killed when over budget
+		Vector2 Focus;                           // Point distances are measured from (such as the center of the camera)
+		float LodDistance;                       // Emitters started further than this from Focus spawn at a reduced rate. 0 disables
+
+		// Constructors
+		EmitterManager(Mini * mini, unsigned int budget = 0);
+		virtual ~EmitterManager();
+
+		/*
+		 * Add:
+		 *		Creates an emitter owned by the manager
+		 *
+		 * maxParticles:
+		 *		Maximum number of particles of the emitter
+		 */
+		Emitter * Add(unsigned int maxParticles);
+
+		/*
+		 * Remove:
+		 *		Deletes an emitter created by Add
+		 *
+		 * emitter:
+		 *		Emitter to delete
+		 */
+		void Remove(Emitter * emitter);
+
+		/*
+		 * Update:
+		 *		Scales spawn rates to the remaining budget and starts updating every running emitter.
+		 *		The updates run in parallel on Mini's job system
+		 *
+		 * deltaTime:
+		 *		Time since last frame
+		 */
+		void Update(float deltaTime);
+
+		/*
+		 * Draw:
+		 *		Draws every running emitter, then kills particles until the total is within budget.
+		 *		Each emitter gives up a share of the excess proportional to its live count. Given deltaTime, updates first
+		 *
+		 * deltaTime:
+		 *		Time since last frame
+		 */
+		void Draw();
+		void Draw(float deltaTime);
+
+		/*
+		 * GetEmitterCount:
+		 *		Returns the number of emitters
+		 */
+		int GetEmitterCount();
+
+		/*
+		 * GetEmitter:
+		 *		Returns an emitter
+		 *
+		 * index:
+		 *		Index of emitter
+		 */
+		Emitter * GetEmitter(int index);
+
+		/*
+		 * GetCost:
+		 *		Returns what an emitter cost in the last frame
+		 *
+		 * index:
+		 *		Index of emitter
+		 */
+		EmitterCost GetCost(int index);
+
+		/*
+		 * GetLiveCount:
+		 *		Returns the number of living particles across every emitter
+		 */
+		int GetLiveCount();
+
+	private:
+		Mini * _mini;
+
+		std::vector<Emitter*> _emitters;         // Owned emitters
+		std::vector<EmitterCost> _costs;         // Cost of each emitter
+		int _live;                               // Living particles after the last Draw
+	};
+
+}
+
+#endif /* MINI2D_EMITTERMANAGER_HPP_ */
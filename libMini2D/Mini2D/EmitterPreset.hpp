@@ -0,0 +1,151 @@
+/*
+ * EmitterPreset.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_EMITTERPRESET_HPP_
+#define MINI2D_EMITTERPRESET_HPP_
+
+#include <time.h>                                // time_t
+#include <string>                                // std::string
+#include <vector>                                // std::vector<>
+
+#include <Mini2D/Mini.hpp>                       // Mini class
+#include <Mini2D/Emitter.hpp>                    // Emitter class
+#include <Mini2D/Units.hpp>                      // Vector2, RectangleF
+
+#define PRESET_MAGIC        0x4D324550           // "M2EP", first four bytes of a binary preset
+#define PRESET_VERSION      1                    // Version of the binary layout
+
+namespace Mini2D {
+
+	/*
+	 * EmitterPreset:
+	 *		Emitter settings loaded from a file or buffer. A preset is parsed once and then only read,
+	 *		so any number of emitters can be created from it or have it applied.
+	 *
+	 *		The text format has one setting per line, a name followed by its values. # starts a comment:
+	 *			MaxParticles 2000
+	 *			RangeTTL 1 2
+	 *			Blend additive
+	 *			Clip 424 256 848 512 0
+	 *			Attractor 424 256 200 300
+	 *			ColorCurve FFFFFFFF FF8000FF 80000000
+	 *		Every Range field, Gravity, ZIndex, EmissionRate, Drag, Restitution, MinParticles, Revive, SkipExplosion and Ballistic
+	 *		are set by name. Blend is normal, additive or multiply. Attractor may be repeated. ColorCurve takes
+	 *		hexadecimal RGBA keys, AlphaCurve and SizeCurve decimal ones. Settings left out keep the Emitter defaults.
+	 *		The binary format (written by Save) holds the same settings in a fixed big endian layout
+	 */
+	class EmitterPreset {
+	public:
+		typedef enum _presetLoadStatus_t {
+			PRESET_SUCCESS = 0,
+			PRESET_INVALID_ARG,                  // Missing file or empty buffer
+			PRESET_INVALID_FORMAT,               // Unknown setting, bad value, or truncated binary
+			PRESET_NO_MEM
+		} PresetLoadStatus;
+
+		// Constructors
+		EmitterPreset();
+		virtual ~EmitterPreset();
+
+		/*
+		 * Load:
+		 *		Parses a text or binary preset. On failure the previous settings are kept
+		 *
+		 * filepath:
+		 *		Path of preset file. Remembered for Reload
+		 * buffer:
+		 *		Preset in memory
+		 * size:
+		 *		Size of buffer
+		 */
+		PresetLoadStatus Load(const char * filepath);
+		PresetLoadStatus Load(const void * buffer, unsigned int size);
+
+		/*
+		 * Save:
+		 *		Writes the settings to a file
+		 *
+		 * filepath:
+		 *		Path of file to write
+		 * binary:
+		 *		Write the binary format instead of text
+		 */
+		bool Save(const char * filepath, bool binary);
+
+		/*
+		 * Reload:
+		 *		Loads the preset's file again if it was modified since it was last loaded.
+		 *		Returns true if the settings changed. Emitters keep their settings until they are applied again
+		 */
+		bool Reload();
+
+		/*
+		 * Create:
+		 *		Creates an emitter with room for MaxParticles and applies the preset to it
+		 *
+		 * mini:
+		 *		Mini the emitter draws with
+		 */
+		Emitter * Create(Mini * mini) const;
+
+		/*
+		 * Apply:
+		 *		Copies every setting onto an emitter. MaxParticles is not applied
+		 *
+		 * emitter:
+		 *		Emitter to configure
+		 */
+		void Apply(Emitter * emitter) const;
+
+		/*
+		 * GetMaxParticles:
+		 *		Returns the number of particles emitters are created with
+		 */
+		unsigned int GetMaxParticles() const;
+
+		/*
+		 * GetVersion:
+		 *		Returns the number of times the preset has been loaded successfully
+		 */
+		unsigned int GetVersion() const;
+
+	private:
+		typedef struct _presetSettings_t {
+			std::vector<Vector2> Vectors;        // Range fields and Gravity, in the order of the vector table
+			std::vector<float> Floats;           // Float fields, in the order of the float table
+			std::vector<bool> Flags;             // Bool fields, in the order of the flag table
+			int MinParticles;                    // -1 uses MaxParticles
+			unsigned int MaxParticles;           // Capped at EMITTER_MAX_PARTICLES
+			Mini::BlendMode Blend;
+			bool HasClip;                        // Clip given. Emitters keep their own otherwise
+			float Clip[5];                       // Center x, center y, width, height, angle
+			std::vector<Emitter::EmitterAttractor> Attractors;
+			std::vector<unsigned int> ColorCurve;
+			std::vector<float> AlphaCurve;
+			std::vector<float> SizeCurve;
+		} PresetSettings;
+
+		PresetSettings _settings;                // Current settings
+		std::string _path;                       // File of last Load (empty if loaded from a buffer)
+		time_t _modified;                        // Modification time of _path when it was loaded
+		unsigned int _version;                   // Successful loads
+
+		// Settings of an emitter left at its defaults
+		static void defaults(PresetSettings * settings);
+		// Parse the text format into settings
+		static PresetLoadStatus parseText(const char * text, unsigned int size, PresetSettings * settings);
+		// Parse the binary format into settings
+		static PresetLoadStatus parseBinary(const unsigned char * data, unsigned int size, PresetSettings * settings);
+		// Write settings in the text format
+		static void writeText(const PresetSettings * settings, std::string * out);
+		// Write settings in the binary format
+		static void writeBinary(const PresetSettings * settings, std::vector<unsigned char> * out);
+	};
+
+}
+
+#endif /* MINI2D_EMITTERPRESET_HPP_ */
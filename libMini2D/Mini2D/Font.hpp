@@ -15,6 +15,9 @@
 #include <Mini2D/Image.hpp>                      // Image class
 #include <Mini2D/Units.hpp>                      // Vector2
 
+#define FONT_TABLE_SIZE     256                  // Characters below this are looked up directly and can be kerned
+#define FONT_KERNING_EMPTY  0xFFFFFFFF           // Pair of an unused kerning slot
+
 namespace Mini2D {
 
 	class Font {
@@ -39,6 +42,14 @@ namespace Mini2D {
 			PRINT_ALIGN_BOTTOMRIGHT
 		} FontPrintAlign;
 
+		typedef struct _fontLine_t {
+			int Start;                           // Index of the line's first character
+			int End;                             // Index after the line's last character (the line break is not included)
+			int Next;                            // Index of the next line's first character
+			float Width;                         // Width of characters Start to End
+			bool Wrapped;                        // Whether the line ended because it reached maxWidth
+		} FontLine;
+
 		u32 BackColor;                           // RGBA background color of text
 		u32 ForeColor;                           // RGBA text color
 
@@ -150,7 +161,7 @@ namespace Mini2D {
 		 * chr:
 		 *		Wide character to associate this image with
 		 * image:
-		 *		Image to draw
+		 *		Image to draw (must not be deleted while the font is in use)
 		 * yCorrection:
 		 *		Y offset from top
 		 *
@@ -183,6 +194,52 @@ namespace Mini2D {
 		 */
 		float GetWidth(wchar_t chr, float size);
 
+		/*
+		 * GetKerning:
+		 *		Returns the change in advance between two characters, from the TTF's kerning pairs
+		 *
+		 * left:
+		 *		First character
+		 * right:
+		 *		Character that follows it
+		 * size:
+		 *		Pixel size per character
+		 */
+		float GetKerning(wchar_t left, wchar_t right, float size);
+
+		/*
+		 * MeasureLine:
+		 *		Measures the line in string that starts at offset
+		 *
+		 * string:
+		 *		wide string
+		 * size:
+		 *		Pixel size per character
+		 * offset:
+		 *		Index of the line's first character
+		 * maxWidth:
+		 *		If greater than 0, the line ends before the first character that would reach past it
+		 * positions:
+		 *		Optional. Appended with the X offset of each character from Start to End
+		 */
+		FontLine MeasureLine(const std::wstring& string, float size, int offset = 0, float maxWidth = 0, std::vector<float> * positions = NULL);
+
+		/*
+		 * MeasureLines:
+		 *		Splits string into lines at line breaks and, if maxWidth is greater than 0, where lines reach past maxWidth.
+		 *		Returns the number of lines
+		 *
+		 * string:
+		 *		wide string
+		 * size:
+		 *		Pixel size per character
+		 * maxWidth:
+		 *		Width to wrap at. 0 only breaks at line breaks
+		 * lines:
+		 *		Appended with each line
+		 */
+		int MeasureLines(const std::wstring& string, float size, float maxWidth, std::vector<FontLine> * lines);
+
 	private:
 		typedef struct _fontChar_t {
 			wchar_t chr;                         // Character code
@@ -196,10 +253,27 @@ namespace Mini2D {
 			u16 p;                               // Pitch of image
 		} FontChar;
 
-		std::vector<FontChar*> CharMap;          // List of characters
+		typedef struct _fontGlyph_t {
+			FontChar * Char;                     // Character to draw
+			int Index;                           // Index in string
+			float X;                             // Offset from the start of the line
+		} FontGlyph;
+
+		typedef struct _fontKerning_t {
+			u32 Pair;                            // Left character << 8 | right character. FONT_KERNING_EMPTY if unused
+			float Offset;                        // Change in advance as a fraction of the font size
+		} FontKerning;
+
+		std::vector<FontChar*> CharMap;          // List of characters, sorted by code
 
 		Mini * _mini;
 
+		FontChar * _table[FONT_TABLE_SIZE];      // Characters below FONT_TABLE_SIZE by code. Others are searched for in CharMap
+		float _advance[FONT_TABLE_SIZE];         // Advance of each table character as a fraction of the font size
+		float _present[FONT_TABLE_SIZE];         // 1 for table characters the font has, 0 otherwise
+		std::vector<FontKerning> _kerning;       // Open addressed hash of kerning pairs. Empty if the font has none
+		std::vector<FontGlyph> _glyphs;          // Glyphs of the line printLine is drawing
+
 		// Load font
 		FontLoadStatus loadFont(const char * path, const void * buffer, int size, u16 r);
 		// Get the scale dimension of given the image dimension, load resolution, and the font size
@@ -210,6 +284,16 @@ namespace Mini2D {
 		float printChar(FontChar * fontChar, float x, float y, float size);
 		// Determine if the character denotes a line break
 		bool isNewline(const std::wstring& string, int strLen, int * index);
+		// Measure a line. With glyphs, records each character the font has in _glyphs
+		FontLine measureLine(const std::wstring& string, float size, int offset, float maxWidth, std::vector<float> * positions, bool glyphs);
+		// Add fontChar to the direct table if its code is small enough
+		void mapChar(FontChar * fontChar);
+		// Bake the kerning pairs between table characters into _kerning
+		void loadKerning(FT_Face face);
+		// Orders CharMap by character code
+		static bool charLess(const FontChar * fontChar, wchar_t chr);
+		// Slot a pair starts probing at in a kerning hash of mask + 1 entries
+		static u32 kerningSlot(u32 pair, u32 mask);
 		// Prints line
 		int printLine(const std::wstring& string, int * startIndex, const Vector2& location, float size, bool useContainer, bool draw);
 		// Convert the glyph into a bitmap and load into the RSX
@@ -8,11 +8,19 @@
 #ifndef MINI2D_IMAGE_HPP_
 #define MINI2D_IMAGE_HPP_
 
+#ifndef MINI2D_PORTABLE_DECODER
 #include <pngdec/pngdec.h>                       // PNG load functions
 #include <jpgdec/jpgdec.h>                       // JPG load functions
+#endif
+
+#include <vector>                                // std::vector<>
 
 #include <Mini2D/Mini.hpp>                       // Mini class
 #include <Mini2D/Units.hpp>                      // Vector2
+#include <Mini2D/Pixel.hpp>                      // Pixel formats
+#include <Mini2D/TextureCache.hpp>               // Shared textures
+
+#define IMAGE_TILED_MAX     64                   // Most tiles DrawTiled draws across or down a non power of two image
 
 namespace Mini2D {
 
@@ -35,25 +43,30 @@ namespace Mini2D {
 		RectangleF DrawRegion;                   // Where to draw image to
 		float ZIndex;                            // Z coordinate (lower numbers are drawn over higher numbers)
 
+		bool Mipmaps;                            // Generate half size copies of the image on Load (set before loading)
+		float MipBias;                           // Added to the mip level picked by Draw. Negative is sharper, positive is faster
+
 		// Constructors
 		Image(Mini * mini);
 		virtual ~Image();
 
 		/*
 		 * Load:
-		 *		Load PNG/JPG image
+		 *		Load PNG/JPG image. Images loaded from the same path with the same format share one texture
 		 *
 		 * filepath:
 		 *		Path to image
+		 * format:
+		 *		Format to store the texture in. PIXEL_FORMAT_AUTO picks one from the image's alpha
 		 *
 		 * Return:
 		 *		Result of load operation
 		 */
-		ImageLoadStatus Load(char * filename);
+		ImageLoadStatus Load(char * filename, Pixel::PixelFormat format = Pixel::PIXEL_FORMAT_A8R8G8B8);
 
 		/*
 		 * Load:
-		 *		Load PNG/JPG image
+		 *		Load PNG/JPG image. Images loaded from buffers with the same contents and format share one texture
 		 *
 		 * buffer:
 		 *		Buffer containing image
@@ -61,11 +74,13 @@ namespace Mini2D {
 		 *		Size of buffer
 		 * type:
 		 *		Type of image the buffer contains
+		 * format:
+		 *		Format to store the texture in. PIXEL_FORMAT_AUTO picks one from the image's alpha
 		 *
 		 * Return:
 		 *		Result of load operation
 		 */
-		ImageLoadStatus Load(void * buffer, unsigned int size, ImageType type);
+		ImageLoadStatus Load(void * buffer, unsigned int size, ImageType type, Pixel::PixelFormat format = Pixel::PIXEL_FORMAT_A8R8G8B8);
 
 		/*
 		 * Load:
@@ -77,8 +92,10 @@ namespace Mini2D {
 		 *		Width of image
 		 * h:
 		 *		Height of image
+		 * format:
+		 *		Format to store the texture in. PIXEL_FORMAT_AUTO picks one from the image's alpha
 		 */
-		void Load(void * argbBuffer, int w, int h);
+		void Load(void * argbBuffer, int w, int h, Pixel::PixelFormat format = Pixel::PIXEL_FORMAT_A8R8G8B8);
 
 		/*
 		 * Draw:
@@ -90,6 +107,74 @@ namespace Mini2D {
 		void Draw(unsigned int rgba = 0xFFFFFFFF);
 		void Draw(unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL);
 
+		/*
+		 * DrawPart:
+		 * 		Draws a region of the image onto the current frame
+		 *
+		 * region:
+		 *		Where to draw to
+		 * z:
+		 *		Z coordinate
+		 * srcX, srcY, srcW, srcH:
+		 *		Region of the image to draw (pixels)
+		 * rgba:
+		 *		Color
+		 */
+		void DrawPart(RectangleF * region, float z, float srcX, float srcY, float srcW, float srcH, unsigned int rgba = 0xFFFFFFFF);
+
+		/*
+		 * DrawNineSlice:
+		 * 		Stretches the image over region while keeping its borders at their original size.
+		 *		The nine parts are drawn as a single primitive
+		 *
+		 * region:
+		 *		Where to draw to
+		 * z:
+		 *		Z coordinate
+		 * left, top, right, bottom:
+		 *		Size of each border (pixels). Borders shrink evenly when region is smaller than them
+		 * rgba:
+		 *		Color
+		 */
+		void DrawNineSlice(RectangleF * region, float z, float left, float top, float right, float bottom, unsigned int rgba = 0xFFFFFFFF);
+
+		/*
+		 * DrawTiled:
+		 * 		Fills region with copies of the image, starting at its top left corner.
+		 *		Power of two images are drawn as one repeating quad, others as one primitive with a quad per tile
+		 *
+		 * region:
+		 *		Where to draw to
+		 * z:
+		 *		Z coordinate
+		 * tileW, tileH:
+		 *		Size of each copy. If zero, the size of the image. Non power of two images grow the tiles
+		 *		so there are at most IMAGE_TILED_MAX across and down
+		 * rgba:
+		 *		Color
+		 */
+		void DrawTiled(RectangleF * region, float z, float tileW = 0, float tileH = 0, unsigned int rgba = 0xFFFFFFFF);
+
+		/*
+		 * DrawQuads:
+		 * 		Draws the whole image onto each of an array of quads as a single primitive with one texture bind.
+		 *		DrawRegion is not used
+		 *
+		 * x:
+		 *		Array of count*4 X coordinates (TopLeft, TopRight, BottomRight, BottomLeft)
+		 * y:
+		 *		Array of count*4 Y coordinates
+		 * count:
+		 *		Number of quads
+		 * z:
+		 *		Z coordinate
+		 * rgba:
+		 *		Array of count colors (one per quad)
+		 * size:
+		 *		Typical size of a quad on screen, used to pick the mip level. If zero, the full size level is used
+		 */
+		void DrawQuads(const float * x, const float * y, int count, float z, const unsigned int * rgba, float size = 0);
+
 		/*
 		 * GetWidth:
 		 *		Returns the width of the image
@@ -108,17 +193,61 @@ namespace Mini2D {
 		 */
 		int GetPitch();
 
+		/*
+		 * GetFormat:
+		 *		Returns the format the texture is stored in
+		 */
+		Pixel::PixelFormat GetFormat();
+
+		/*
+		 * GetMipCount:
+		 *		Returns the number of mip levels, including the full size image
+		 */
+		int GetMipCount();
+
 	private:
 		Mini * _mini;
 
 		int _width, _height, _pitch;             // Width, height, and pitch of loaded image
 		float _sWidth, _sHeight;                 // Width and height in terms of screen scale
 		unsigned int _textureOff;                // RSX offset to texture
+		TextureCache::Texture _texture;          // Uploaded texture and its mip levels
+		TextureCache::CacheEntry * _cached;      // Cache entry holding _texture (null if not shared)
+		std::vector<float> _quads;               // Scratch x, y, u, v arrays for DrawNineSlice and DrawTiled
+		std::vector<unsigned int> _quadColors;   // Scratch colors for DrawNineSlice and DrawTiled
 
 		// Load PNG and JPG dec modules
 		void loadModules();
-		// Move loaded image to RSX
-		void toRSX(void * buffer);
+		// Drop the current texture, freeing it if this was the last Image using it
+		void release();
+		// Look up a cached texture. Returns 1 and uses it if found
+		bool acquire(unsigned long long key);
+		// Key for a source hash, format, mipmap and premultiplied alpha settings
+		unsigned long long cacheKey(unsigned long long source, Pixel::PixelFormat format);
+		// Move loaded image to RSX and add it to the cache
+		void toRSX(void * buffer, Pixel::PixelFormat format, unsigned long long key);
+		// Decode with Decoder and add it to the cache (MINI2D_PORTABLE_DECODER only)
+		ImageLoadStatus decode(const void * buffer, unsigned int size, ImageType type, Pixel::PixelFormat format, unsigned long long key);
+		// Allocate the texture heap range for every level of a w by h texture
+		bool reserve(int w, int h, Pixel::PixelFormat format);
+		// Convert ARGB pixels into the texture heap. If premultiply is set, a premultiplied copy of argb is uploaded
+		void upload(const unsigned int * argb, int w, int h, int pitch, Pixel::PixelFormat format, bool premultiply);
+		// Pixel::Convert split into bands of rows on Mini's job system
+		bool convertPixels(const unsigned int * argb, int w, int h, int pitch, Pixel::PixelFormat format, void * out);
+		// Pixel::Premultiply split into bands of rows on Mini's job system
+		void premultiplyPixels(unsigned int * argb, int w, int h, int pitch);
+		// Downsample and convert every mip level after the first into the texture heap
+		void uploadMips(const unsigned int * argb, int w, int h, int pitch);
+		// Copy level 0 of _texture into _width, _height, _pitch and _textureOff
+		void useTexture();
+		// Pick the mip level for drawing a texture region of texW by texH pixels at w by h
+		int selectMip(float texW, float texH, float w, float h);
+		// Resize the scratch buffers to hold count quads
+		void reserveQuads(int count);
+		// Rotate count quads of the scratch buffer around nx,ny by region's angle and draw them from mip level
+		void drawQuads(RectangleF * region, float z, float nx, float ny, int count, int level, unsigned int rgba, bool repeat);
+		// Draw texture coordinates u0,v0 to u1,v1 into region
+		void draw(RectangleF * region, float z, float u0, float v0, float u1, float v1, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL);
 	};
 
 }
@@ -0,0 +1,136 @@
+/*
+ * JobSystem.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_JOBSYSTEM_HPP_
+#define MINI2D_JOBSYSTEM_HPP_
+
+#include <sys/thread.h>                          // Worker threads
+#include <sys/sem.h>                             // Worker wake up
+
+#define JOB_QUEUE_SIZE      256                  // Jobs each queue holds (power of 2). Jobs forked onto a full queue run immediately
+
+namespace Mini2D {
+
+	/*
+	 * JobSystem:
+	 *		Work stealing thread pool. Each worker keeps its own queue of jobs and takes from the others when it runs out.
+	 *		Threads waiting on a JobHandle run jobs while they wait, so a system of 0 workers runs everything on the caller
+	 */
+	class JobSystem {
+	public:
+		/*
+		 * JobFunction_f:
+		 *		Runs one job over a range of items
+		 *
+		 * void *:
+		 *		Job data
+		 * int:
+		 *		First item
+		 * int:
+		 *		One past the last item
+		 */
+		typedef void (*JobFunction_f) (void *, int, int);
+
+		typedef struct _jobHandle_t {
+			volatile int Pending;                // Jobs forked on this handle that have not finished
+		} JobHandle;
+
+		// Constructors
+		JobSystem(int workers);
+		virtual ~JobSystem();
+
+		/*
+		 * Fork:
+		 *		Queues a job for any thread to run. Join the handle before reading the job's results
+		 *
+		 * handle:
+		 *		Handle the job is counted on. Must start zeroed and outlive the job
+		 * function:
+		 *		Function to run
+		 * data:
+		 *		Job data
+		 * start:
+		 *		First item passed to function
+		 * end:
+		 *		One past the last item passed to function
+		 */
+		void Fork(JobHandle * handle, JobFunction_f function, void * data, int start = 0, int end = 1);
+
+		/*
+		 * Join:
+		 *		Runs queued jobs until every job forked on handle has finished
+		 *
+		 * handle:
+		 *		Handle to wait on
+		 */
+		void Join(JobHandle * handle);
+
+		/*
+		 * ParallelFor:
+		 *		Splits 0 to count into ranges, runs them in parallel and returns once they have all finished
+		 *
+		 * function:
+		 *		Function to run on each range
+		 * data:
+		 *		Job data
+		 * count:
+		 *		Number of items
+		 * grain:
+		 *		Items per range. 0 picks a size that gives every thread a few ranges
+		 */
+		void ParallelFor(JobFunction_f function, void * data, int count, int grain = 0);
+
+		/*
+		 * GetWorkerCount:
+		 *		Returns the number of threads, not counting threads that join
+		 */
+		int GetWorkerCount();
+
+	private:
+		typedef struct _job_t {
+			JobFunction_f Function;
+			void * Data;
+			int Start, End;
+			JobHandle * Handle;
+		} Job;
+
+		typedef struct _worker_t {
+			JobSystem * System;
+			sys_ppu_thread_t Thread;
+			bool Running;                        // Whether the thread started
+			volatile int Lock;                   // Spin lock over the queue
+			unsigned int Top, Bottom;            // Others steal from Top, the owner pushes and pops at Bottom
+			Job Jobs[JOB_QUEUE_SIZE];
+		} Worker;
+
+		Worker * _workers;                       // One per thread, plus one shared by threads outside the system (last)
+		int _workerCount;                        // Number of threads
+		sys_sem_t _wake;                         // Posted when jobs are queued and a worker is asleep
+		volatile int _sleeping;                  // Number of workers waiting on _wake
+		volatile bool _exit;                     // Whether workers should return
+
+		// Queue of the calling thread
+		int current();
+		// Add a job to the bottom of a queue. Returns false if it is full
+		bool push(int queue, const Job * job);
+		// Take the newest job of a queue
+		bool pop(int queue, Job * job);
+		// Take the oldest job of a queue
+		bool steal(int queue, Job * job);
+		// Take a job from queue, or else from any other
+		bool find(int queue, Job * job);
+		// Run a job and count it as finished
+		void run(Job * job);
+		// Wake up to count sleeping workers
+		void wake(int count);
+		// Entry point of worker threads
+		static void workerThread(void * worker);
+	};
+
+}
+
+#endif /* MINI2D_JOBSYSTEM_HPP_ */
@@ -0,0 +1,100 @@
+/*
+ * Layer.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_LAYER_HPP_
+#define MINI2D_LAYER_HPP_
+
+#include <Mini2D/Mini.hpp>                       // Mini class
+#include <Mini2D/Units.hpp>                      // RectangleF
+
+namespace Mini2D {
+
+	/*
+	 * Layer:
+	 *		Offscreen texture that caches mostly static draws (panels, labels, backgrounds).
+	 *		Draws between Begin and End are rendered into the layer once, then Draw blits it as a single quad
+	 *		until Invalidate is called. Layers composite exactly with premultiplied alpha (Mini::SetPremultipliedAlpha)
+	 *
+	 *		if (layer->Begin()) {
+	 *			... draws ...
+	 *			layer->End();
+	 *		}
+	 *		layer->Draw();
+	 */
+	class Layer {
+	public:
+		RectangleF DrawRegion;                   // Where to draw layer to
+		float ZIndex;                            // Z coordinate (lower numbers are drawn over higher numbers)
+		unsigned int ClearColor;                 // ARGB color the layer is cleared to before rendering (transparent by default)
+
+		// Constructors
+		Layer(Mini * mini, int width, int height);
+		virtual ~Layer();
+
+		/*
+		 * Begin:
+		 *		Starts rendering into the layer if it has been invalidated. Call at the start of a frame,
+		 *		before drawing to the screen. Coordinates are relative to the top left of the layer
+		 *
+		 * Return:
+		 *		1 if the layer must be redrawn (call End after drawing). 0 if the cached contents are still valid
+		 */
+		bool Begin();
+
+		/*
+		 * End:
+		 *		Finishes rendering into the layer and returns drawing to the screen
+		 */
+		void End();
+
+		/*
+		 * Invalidate:
+		 *		Marks the contents as out of date so the next Begin redraws them
+		 */
+		void Invalidate();
+
+		/*
+		 * IsValid:
+		 *		Returns whether the layer has been rendered since it was last invalidated
+		 */
+		bool IsValid();
+
+		/*
+		 * Draw:
+		 * 		Draws the layer onto the current frame
+		 *
+		 * rgba:
+		 *		Color
+		 */
+		void Draw(unsigned int rgba = 0xFFFFFFFF);
+
+		/*
+		 * GetWidth:
+		 *		Returns the width of the layer
+		 */
+		int GetWidth();
+
+		/*
+		 * GetHeight:
+		 *		Returns the height of the layer
+		 */
+		int GetHeight();
+
+	private:
+		Mini * _mini;
+
+		int _width, _height, _pitch;             // Size of texture
+		void * _pointer;                         // Texture heap allocation
+		unsigned int _size;                      // Size of allocation
+		unsigned int _textureOff;                // RSX offset to texture (64 byte aligned within the allocation)
+		bool _valid;                             // Whether the texture holds the current contents
+		bool _rendering;                         // Whether between Begin and End
+	};
+
+}
+
+#endif /* MINI2D_LAYER_HPP_ */
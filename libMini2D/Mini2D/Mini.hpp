@@ -11,6 +11,8 @@
 #include <io/pad.h>                              // Pad functions
 #include <sys/time.h>                            // For FPS / deltaTime calculation
 #include <sys/spu.h>                             // sysSpuImage type
+#include <sys/thread.h>                          // Render thread
+#include <sys/sem.h>                             // Render thread handoff
 
 extern "C" {
     #include <soundlib/audioplayer.h>            // SPU sound playback
@@ -19,10 +21,20 @@ extern "C" {
 #include <ft2build.h>                            // Freetype header
 #include <freetype/freetype.h>                   // FT_Library
 
+#include <vector>                               // std::vector<>
+
+#include <tiny3d.h>                              // MATRIX
+
+#include <Mini2D/DrawQueue.hpp>                  // DrawQueue class
+
 #define SPU_SIZE(x) (((x)+127) & ~127)
 
 namespace Mini2D {
 
+	class Camera;
+	class TextureCache;
+	class JobSystem;
+
 	class Mini {
 	public:
 		typedef enum _padChangedInfo_t {
@@ -89,6 +101,30 @@ namespace Mini2D {
 		 */
 		typedef void (*ExitCallback_f) ();
 
+		typedef enum _drawSpace_t {
+			DRAW_SPACE_SCREEN = 0,               // Coordinates are in screen pixels
+			DRAW_SPACE_WORLD                     // Coordinates are transformed by the active camera
+		} DrawSpace;
+
+		typedef enum _blendMode_t {
+			BLEND_NORMAL = 0,                    // Alpha blending
+			BLEND_ADDITIVE,                      // Adds color to what is behind
+			BLEND_MULTIPLY                       // Multiplies what is behind by color
+		} BlendMode;
+
+		typedef struct _drawStats_t {
+			unsigned int Submitted;              // Number of draws sent to the RSX
+			unsigned int Culled;                 // Number of draws dropped because they were entirely outside the viewport
+		} DrawStats;
+
+		typedef struct _frameStats_t {
+			float RecordTime;                    // Time spent in the draw callback (ms)
+			float SubmitTime;                    // Time spent sorting and sending queued draws to the RSX (ms)
+			float FlipTime;                      // Time spent waiting on tiny3d_Flip (ms)
+			float Latency;                       // Time from the start of recording a frame to its flip (ms)
+			float FrameTime;                     // Time between the last two Flip() calls (ms)
+		} FrameStats;
+
 
 		u32 * TexturePointer;                    // Active pointer to unused texture vram
 		bool XMB;                                // Whether or not the in-game XMB is currently being displayed
@@ -147,9 +183,169 @@ namespace Mini2D {
 		 */
 		void SetAlphaState(bool enable);
 
+		/*
+		 * SetPremultipliedAlpha:
+		 * 		Enable or disable premultiplied alpha. When enabled, Images are premultiplied when loaded and
+		 *		BLEND_NORMAL and BLEND_ADDITIVE draws share one blend state, so they batch without state changes.
+		 *		Set before loading images
+		 *
+		 * enable:
+		 * 		True to use premultiplied alpha
+		 */
+		void SetPremultipliedAlpha(bool enable);
+
+		/*
+		 * GetPremultipliedAlpha:
+		 * 		Returns whether premultiplied alpha is enabled
+		 */
+		bool GetPremultipliedAlpha();
+
+		/*
+		 * SetBlendMode:
+		 * 		Sets the blend mode of all following draws. Every frame starts in BLEND_NORMAL.
+		 *		Without premultiplied alpha, BLEND_MULTIPLY ignores alpha
+		 *
+		 * mode:
+		 * 		Blend mode
+		 */
+		void SetBlendMode(BlendMode mode);
+
+		/*
+		 * GetBlendMode:
+		 * 		Returns the blend mode of current draws
+		 */
+		BlendMode GetBlendMode();
+
+		/*
+		 * SetCullState:
+		 * 		Enable or disable viewport culling. When enabled, draws that fall entirely outside the screen are dropped
+		 *
+		 * enable:
+		 * 		True to enable culling (default)
+		 */
+		void SetCullState(bool enable);
+
+		/*
+		 * SetCamera:
+		 * 		Sets the camera used to transform draws made in DRAW_SPACE_WORLD
+		 *
+		 * camera:
+		 * 		Camera (can be null)
+		 */
+		void SetCamera(Camera * camera);
+
+		/*
+		 * SetDrawSpace:
+		 * 		Sets the space of all following draws. Every frame starts in DRAW_SPACE_SCREEN.
+		 *		The camera is read when switching to DRAW_SPACE_WORLD, so move it before switching
+		 *
+		 * space:
+		 * 		Draw space
+		 */
+		void SetDrawSpace(DrawSpace space);
+
+		/*
+		 * SetDrawQueue:
+		 * 		Sets the queue that draws are recorded into. While set, draws are deferred until Flip(),
+		 *		where they are sorted back to front by layer and grouped by texture before being submitted.
+		 *		If null (default), draws are submitted immediately in call order
+		 *
+		 * queue:
+		 * 		Draw queue (can be null)
+		 */
+		void SetDrawQueue(DrawQueue * queue);
+
+		/*
+		 * BeginRenderTarget:
+		 * 		Clears a texture and redirects all following draws into it until EndRenderTarget.
+		 *		Draws are immediate and in screen space, with 0,0 at the top left of the texture.
+		 *		The depth buffer is shared with the screen, so render targets at the start of a frame (see Layer)
+		 *
+		 * textureOff:
+		 * 		RSX offset to A8R8G8B8 texture (64 byte aligned)
+		 * width:
+		 * 		Width of texture
+		 * height:
+		 * 		Height of texture
+		 * pitch:
+		 * 		Number of bytes per row (multiple of 64)
+		 * clearColor:
+		 * 		ARGB color to clear the texture to
+		 *
+		 * Return:
+		 * 		1 if drawing into the texture. 0 if a target is already active or the arguments are invalid
+		 */
+		bool BeginRenderTarget(unsigned int textureOff, int width, int height, int pitch, unsigned int clearColor = 0);
+
+		/*
+		 * EndRenderTarget:
+		 * 		Returns drawing to the screen, restoring the draw queue and draw space set before BeginRenderTarget
+		 */
+		void EndRenderTarget();
+
+		/*
+		 * GetDrawScale:
+		 *		Returns the scale the current draw space is displayed at (the camera zoom in DRAW_SPACE_WORLD, otherwise 1)
+		 */
+		float GetDrawScale();
+
+		/*
+		 * SetPipelined:
+		 * 		Enables or disables pipelined drawing, starting with the next frame. While enabled, draws are recorded
+		 *		into one of two draw queues and Flip() hands the finished queue to a render thread, which submits it
+		 *		and waits on tiny3d_Flip while the next frame is recorded. Frames are displayed one frame later.
+		 *		Render targets and freeing textures wait for the render thread to go idle. A queue set with
+		 *		SetDrawQueue replaces the recording queue until it is set back to null or the frame ends,
+		 *		and is not drawn by Flip()
+		 *
+		 * enable:
+		 * 		Whether to draw on a render thread
+		 */
+		void SetPipelined(bool enable);
+
+		/*
+		 * GetPipelined:
+		 * 		Returns whether the render thread is running
+		 */
+		bool GetPipelined();
+
+		/*
+		 * GetFrameStats:
+		 *		Returns the timings of the last frame that was flipped. When pipelined, RecordTime is of the newest
+		 *		recorded frame and the others are of the frame before it
+		 */
+		FrameStats GetFrameStats();
+
+		/*
+		 * GetDrawStats:
+		 *		Returns the number of submitted and culled draws of the last completed frame
+		 */
+		DrawStats GetDrawStats();
+
+		/*
+		 * GetTextureCache:
+		 *		Returns the cache Images share decoded textures through
+		 */
+		TextureCache * GetTextureCache();
+
+		/*
+		 * GetJobSystem:
+		 *		Returns the job system library subsystems run parallel work on
+		 */
+		JobSystem * GetJobSystem();
+
+		/*
+		 * SetJobWorkers:
+		 *		Replaces the job system with one of a different size. No jobs may be running
+		 *
+		 * workers:
+		 *		Number of worker threads (0 runs jobs on the threads that wait for them)
+		 */
+		void SetJobWorkers(int workers);
+
 		/*
 		 * ResetTexturePointer:
-		 *		Resets texture pointer. Used to pop the entire texture heap
+		 *		Resets texture pointer. Used to pop the entire texture heap (also forgets freed space and cached textures)
 		 */
 		void ResetTexturePointer();
 
@@ -169,6 +365,32 @@ namespace Mini2D {
 		 */
 		unsigned int AddTexture(void * pixelData, int pitch, int height);
 
+		/*
+		 * AllocTexture:
+		 *		Reserve space in the texture heap to write a texture into directly
+		 *
+		 * size:
+		 * 		Number of bytes
+		 * textureOff [OUT]:
+		 * 		Texture offset in RSX (can be null)
+		 *
+		 * Return:
+		 * 		Pointer to the reserved space. Null if the heap is full
+		 */
+		void * AllocTexture(unsigned int size, unsigned int * textureOff);
+
+		/*
+		 * FreeTexture:
+		 *		Return space reserved by AllocTexture to the texture heap so later allocations can reuse it.
+		 *		If draws are still queued, the space is reused only after they have been submitted (at Flip)
+		 *
+		 * pointer:
+		 * 		Pointer returned by AllocTexture
+		 * size:
+		 * 		Number of bytes passed to AllocTexture
+		 */
+		void FreeTexture(void * pointer, unsigned int size);
+
 		/*
 		 * DrawTexture:
 		 * 		Draws the texture onto the currect frame
@@ -197,15 +419,56 @@ namespace Mini2D {
 		 * 		New height
 		 * rgba:
 		 * 		RGBA color
+		 * rgbaTL, rgbaTR, rgbaBR, rgbaBL:
+		 *		RGBA color of each corner (TopLeft, TopRight, BottomRight, BottomLeft), blended across the image
 		 * angle:
 		 * 		Angle to rotate image (degrees)
 		 * colorFormat:
 		 *		Tiny3D pixel format
 		 */
-		void DrawTexture(u32 textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle, unsigned int colorFormat);
+		void DrawTexture(unsigned int textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle, unsigned int colorFormat);
 		void DrawTexture(unsigned int textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, unsigned int rgba, float angle, unsigned int colorFormat);
 		void DrawTexture(unsigned int textureOff, int pitch, int width, int height, float x, float y, float z, float w, float h, unsigned int rgba, float angle, unsigned int colorFormat);
 
+		/*
+		 * DrawTextureRegion:
+		 * 		Draws part of the texture onto the currect frame
+		 *
+		 * textureOff:
+		 * 		RSX offset to texture
+		 * pitch:
+		 * 		Number of bytes per row
+		 * width
+		 * 		Width of image
+		 * height:
+		 * 		Height of image
+		 * xAnchor:
+		 *		X coordinate to rotate around
+		 * yAnchor:
+		 *		Y coordinate to rotate around
+		 * x:
+		 * 		X coordinate
+		 * y:
+		 * 		Y coordinate
+		 * z:
+		 *		Z coordinate
+		 * w:
+		 * 		New width
+		 * h:
+		 * 		New height
+		 * u0, v0:
+		 *		Texture coordinate of the top left corner (0 to 1)
+		 * u1, v1:
+		 *		Texture coordinate of the bottom right corner (0 to 1)
+		 * rgba:
+		 * 		RGBA color of each corner
+		 * angle:
+		 * 		Angle to rotate image (degrees)
+		 * colorFormat:
+		 *		Tiny3D pixel format
+		 */
+		void DrawTextureRegion(unsigned int textureOff, int pitch, int width, int height, float xAnchor, float yAnchor, float x, float y, float z, float w, float h, float u0, float v0, float u1, float v1, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle, unsigned int colorFormat);
+
 		/*
 		 * DrawRectangle:
 		 *		Draws the rectangle onto the current frame
@@ -226,10 +489,83 @@ namespace Mini2D {
 		 * 		Height
 		 * rgba:
 		 * 		Color
+		 * rgbaTL, rgbaTR, rgbaBR, rgbaBL:
+		 * 		Color of each corner (blended across the rectangle)
 		 * angle:
 		 * 		Angle of rotation (degrees)
 		 */
 		void DrawRectangle(float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, unsigned int rgba, float angle);
+		void DrawRectangle(float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle);
+
+		/*
+		 * DrawTextureQuads:
+		 *		Draws an array of textured quads onto the current frame as a single primitive.
+		 *		Vertices are in draw order (TopLeft, TopRight, BottomRight, BottomLeft) as written by RectangleF::GetCorners()
+		 *
+		 * textureOff:
+		 * 		RSX offset to texture
+		 * pitch:
+		 * 		Number of bytes per row
+		 * width
+		 * 		Width of image
+		 * height:
+		 * 		Height of image
+		 * x:
+		 *		Array of count*4 X coordinates
+		 * y:
+		 *		Array of count*4 Y coordinates
+		 * u:
+		 *		Array of count*4 U texture coordinates. If null the entire texture is mapped to each quad
+		 * v:
+		 *		Array of count*4 V texture coordinates. If null the entire texture is mapped to each quad
+		 * count:
+		 *		Number of quads
+		 * z:
+		 *		Z coordinate
+		 * rgba:
+		 *		Array of count RGBA colors (one per quad). If null, white is used
+		 * colorFormat:
+		 *		Tiny3D pixel format
+		 * repeat:
+		 *		Wrap texture coordinates outside 0-1 instead of clamping them (power of two textures only)
+		 */
+		void DrawTextureQuads(unsigned int textureOff, int pitch, int width, int height, const float * x, const float * y, const float * u, const float * v, int count, float z, const unsigned int * rgba, unsigned int colorFormat, bool repeat = 0);
+
+		/*
+		 * DrawRectangleQuads:
+		 *		Draws an array of untextured quads onto the current frame as a single primitive.
+		 *		Vertices are in draw order (TopLeft, TopRight, BottomRight, BottomLeft) as written by RectangleF::GetCorners()
+		 *
+		 * x:
+		 *		Array of count*4 X coordinates
+		 * y:
+		 *		Array of count*4 Y coordinates
+		 * count:
+		 *		Number of quads
+		 * z:
+		 *		Z coordinate
+		 * rgba:
+		 *		Array of count RGBA colors (one per quad)
+		 */
+		void DrawRectangleQuads(const float * x, const float * y, int count, float z, const unsigned int * rgba);
+
+		/*
+		 * DrawColoredQuads:
+		 *		Draws an array of untextured quads with a color per vertex onto the current frame as a single primitive.
+		 *		Each quad must be convex. Triangles can be drawn by repeating their last vertex
+		 *
+		 * x:
+		 *		Array of count*4 X coordinates
+		 * y:
+		 *		Array of count*4 Y coordinates
+		 * count:
+		 *		Number of quads
+		 * z:
+		 *		Z coordinate
+		 * rgba:
+		 *		Array of count*4 RGBA colors (one per vertex)
+		 */
+		void DrawColoredQuads(const float * x, const float * y, int count, float z, const unsigned int * rgba);
 
 
 	private:
@@ -238,6 +574,47 @@ namespace Mini2D {
 
 		unsigned int _clearColor;                // Value to clear screen to on every draw
 		int _alphaEnabled;                       // Whether alpha testing is enabled
+		bool _cullEnabled;                       // Whether viewport culling is enabled
+
+		Camera * _camera;                        // Camera used for DRAW_SPACE_WORLD
+		DrawSpace _drawSpace;                    // Space of current draws
+		bool _worldView;                         // Whether _viewMatrix is applied to draws
+		int _viewIndex;                          // Index of _viewMatrix in _drawQueue (-1 for screen space)
+		MATRIX _viewMatrix;                      // Camera transform
+		float _viewMinX, _viewMinY;              // Visible region in the current draw space (used for culling)
+		float _viewMaxX, _viewMaxY;
+
+		DrawQueue * _drawQueue;                  // Queue draws are recorded into (null for immediate)
+
+		bool _renderTarget;                      // Whether draws go to a texture instead of the screen
+		DrawQueue * _targetQueue;                // _drawQueue before BeginRenderTarget
+		DrawSpace _targetSpace;                  // _drawSpace before BeginRenderTarget
+
+		bool _premultiplied;                     // Whether premultiplied alpha is enabled
+		BlendMode _blendMode;                    // Blend mode of current draws
+		int _blendState;                         // Blend state last sent to the RSX (-1 if unknown). Only the render thread uses it while pipelined
+
+		DrawStats _drawStats;                    // Draw counts of the current frame
+		DrawStats _lastDrawStats;                // Draw counts of the last completed frame
+
+		typedef struct _renderFrame_t {
+			DrawQueue * Queue;                   // Recorded draws
+			unsigned int ClearColor;             // Clear color when recorded
+			int AlphaEnabled;                    // Alpha test state when recorded
+			double RecordStart;                  // Time recording began (ms)
+		} RenderFrame;
+
+		bool _pipelined;                         // Whether the render thread is running
+		bool _pipelineRequest;                   // Value of _pipelined after the next Flip()
+		RenderFrame _frames[2];                  // Frames recorded in turn while pipelined
+		int _recordIndex;                        // Index of the frame being recorded
+		RenderFrame * volatile _pendingFrame;    // Frame handed to the render thread (exchanged atomically)
+		sys_ppu_thread_t _renderThread;          // Submits frames while pipelined
+		sys_sem_t _frameReady;                   // Posted when a frame is handed to the render thread
+		sys_sem_t _frameDone;                    // Posted when the render thread is idle
+		double _recordStart;                     // Time the current frame began (ms)
+		FrameStats _frameStats;                  // Timings of the last flipped frame
+		FrameStats _renderStats;                 // Timings written by the render thread
 
 		float _maxW;                             // MAXW refers to
 		float _minW;                             // MINW refers to
@@ -253,14 +630,67 @@ namespace Mini2D {
 		padData _padData[MAX_PORT_NUM];          // Pad data
 		unsigned short _analogDeadzone;          // Deadzone of analog sticks
 
+		typedef struct _textureBlock_t {
+			unsigned char * pointer;             // Start of block
+			unsigned int size;                   // Size of block (multiple of 16)
+		} TextureBlock;
+
 		void * _textureMem;                      // Pointer to vram
+		std::vector<TextureBlock> _freeTextures; // Freed blocks below TexturePointer, sorted by address
+		std::vector<TextureBlock> _pendingTextures; // Blocks freed while the current frame was recorded
+		std::vector<TextureBlock> _flightTextures; // Blocks freed while the frame in flight was recorded (pipelined)
+		TextureCache * _textureCache;            // Decoded textures shared between Images
+		JobSystem * _jobSystem;                  // Worker threads for parallel work
 
 		u32 _spu;                                //
 		u32 _spuInited;                          // SPU Init status
 		sysSpuImage _spuImage;                   // Image holding sound module
 
+		// Rebuild the view matrix and visible region
+		void updateView();
+		// Returns true (and counts it) if the rotated rectangle is entirely outside the viewport
+		bool cullRectangle(float xAnchor, float yAnchor, float x, float y, float w, float h, float angle);
+		// Returns true (and counts it) if the quad is entirely outside the viewport
+		bool cullQuad(const float * x, const float * y);
+
+		// Send alpha test, blend state and 2D projection to the RSX (needed whenever the render surface changes)
+		void applyState();
+		// Blend state of current draws. BLEND_NORMAL and BLEND_ADDITIVE share one when premultiplied
+		unsigned int blendState();
+		// Send a blend state to the RSX if it is not already set. alphaEnabled is the alpha state of the frame being drawn
+		void setBlendState(unsigned int state, int alphaEnabled);
+		// Convert a draw color for the current blend mode
+		unsigned int blendColor(unsigned int rgba);
+
+		// Fill in the common fields of a queued command
+		void initCommand(DrawQueue::DrawCommand * command, DrawQueue::DrawCommandType type, float z);
+		// Record a batch of quads into the queue, dropping culled quads
+		void queueQuads(DrawQueue::DrawCommand * command, const float * x, const float * y, const float * u, const float * v, int count, const unsigned int * rgba, bool vertexColors = 0);
+		// Sort and submit every queued draw
+		void submitQueue();
+		// Sort and send a queue to the RSX with the alpha state it was recorded with
+		void submit(DrawQueue * queue, int alphaEnabled);
+
+		// Return a block to the free list, merging it with its neighbours
+		void releaseTexture(TextureBlock block);
+		// Return every block in a list to the free list and empty it
+		void releaseTextures(std::vector<TextureBlock> * blocks);
+
+		// Create the frame queues and start the render thread
+		bool startRender();
+		// Finish the frame in flight and stop the render thread
+		void stopRender();
+		// Block until the render thread has flipped the frame it was given
+		void waitForRender();
+		// Render thread body. Submits and flips frames until handed null
+		void renderLoop();
+		// Entry point of the render thread
+		static void renderThread(void * mini);
+
+		// Draw rectangle with rotation
+		void drawRectangle(const MATRIX * view, float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL, float angle);
 		// Draw texture with rotation
-		void drawSpriteRot(float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, u32 rgba0, u32 rgba1, u32 rgba2, u32 rgba3, float angle);
+		void drawSpriteRot(const MATRIX * view, float xAnchor, float yAnchor, float x, float y, float layer, float dx, float dy, float u0, float v0, float u1, float v1, u32 rgba0, u32 rgba1, u32 rgba2, u32 rgba3, float angle);
 
 		// Initialize SPU and sound modules
 		void initSPU();
@@ -0,0 +1,193 @@
+/*
+ * Pixel.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_PIXEL_HPP_
+#define MINI2D_PIXEL_HPP_
+
+namespace Mini2D {
+
+	class Pixel {
+	public:
+		typedef enum _pixelFormat_t {
+			PIXEL_FORMAT_AUTO = 0,               // Chosen from alpha content (see ChooseFormat)
+			PIXEL_FORMAT_A8R8G8B8,               // 32 bits per pixel
+			PIXEL_FORMAT_R5G6B5,                 // 16 bits per pixel, no alpha
+			PIXEL_FORMAT_A4R4G4B4,               // 16 bits per pixel, 16 levels of alpha
+			PIXEL_FORMAT_A1R5G5B5,               // 16 bits per pixel, alpha on or off
+			PIXEL_FORMAT_L8,                     // 8 bits per pixel, luminance only
+			PIXEL_FORMAT_DXT1,                   // 4 bits per pixel, alpha on or off
+			PIXEL_FORMAT_DXT3,                   // 8 bits per pixel, 16 levels of alpha
+			PIXEL_FORMAT_DXT5                    // 8 bits per pixel, interpolated alpha
+		} PixelFormat;
+
+		typedef enum _alphaType_t {
+			PIXEL_ALPHA_OPAQUE = 0,              // Every pixel has an alpha of 255
+			PIXEL_ALPHA_BINARY,                  // Every pixel has an alpha of 0 or 255
+			PIXEL_ALPHA_FULL                     // Partially transparent pixels
+		} AlphaType;
+
+		/*
+		 * GetAlphaType:
+		 *		Determines how an image uses its alpha channel
+		 *
+		 * argb:
+		 *		Array of ARGB pixels
+		 * width:
+		 *		Width of image
+		 * height:
+		 *		Height of image
+		 * pitch:
+		 *		Number of bytes per row
+		 */
+		static AlphaType GetAlphaType(const unsigned int * argb, int width, int height, int pitch);
+
+		/*
+		 * ChooseFormat:
+		 *		Picks the smallest uncompressed format that keeps the image's alpha.
+		 *		Opaque images use R5G6B5, binary alpha uses A1R5G5B5 and anything else stays A8R8G8B8
+		 *
+		 * argb:
+		 *		Array of ARGB pixels
+		 * width:
+		 *		Width of image
+		 * height:
+		 *		Height of image
+		 * pitch:
+		 *		Number of bytes per row
+		 */
+		static PixelFormat ChooseFormat(const unsigned int * argb, int width, int height, int pitch);
+
+		/*
+		 * GetPitch:
+		 *		Returns the number of bytes per row of a converted image. For DXT formats, a row is a row of 4x4 blocks
+		 *
+		 * format:
+		 *		Pixel format
+		 * width:
+		 *		Width of image
+		 */
+		static int GetPitch(PixelFormat format, int width);
+
+		/*
+		 * GetRows:
+		 *		Returns the number of rows of a converted image. For DXT formats, a row is a row of 4x4 blocks
+		 *
+		 * format:
+		 *		Pixel format
+		 * height:
+		 *		Height of image
+		 */
+		static int GetRows(PixelFormat format, int height);
+
+		/*
+		 * GetTiny3DFormat:
+		 *		Returns the Tiny3D texture format of a pixel format
+		 *
+		 * format:
+		 *		Pixel format
+		 */
+		static unsigned int GetTiny3DFormat(PixelFormat format);
+
+		/*
+		 * Convert:
+		 *		Converts an ARGB image. 16 and 8 bit formats are converted with AltiVec when rows are 16 byte aligned
+		 *
+		 * argb:
+		 *		Array of ARGB pixels
+		 * width:
+		 *		Width of image
+		 * height:
+		 *		Height of image
+		 * pitch:
+		 *		Number of bytes per row
+		 * format:
+		 *		Format to convert to (not PIXEL_FORMAT_AUTO)
+		 * out [OUT]:
+		 *		Converted image. Must hold GetPitch(format, width) * GetRows(format, height) bytes
+		 *
+		 * Return:
+		 *		1 if converted. 0 if invalid arguments
+		 */
+		static bool Convert(const unsigned int * argb, int width, int height, int pitch, PixelFormat format, void * out);
+
+		/*
+		 * Downsample:
+		 *		Halves an ARGB image with a 2x2 box filter. Odd sizes drop the last row/column and sizes of 1 stay 1.
+		 *		Uses AltiVec when rows are 16 byte aligned
+		 *
+		 * argb:
+		 *		Array of ARGB pixels
+		 * width:
+		 *		Width of image
+		 * height:
+		 *		Height of image
+		 * pitch:
+		 *		Number of bytes per row
+		 * out [OUT]:
+		 *		Downsampled image (width/2 by height/2, at least 1 by 1)
+		 * outPitch:
+		 *		Number of bytes per row of out
+		 */
+		static void Downsample(const unsigned int * argb, int width, int height, int pitch, unsigned int * out, int outPitch);
+
+		/*
+		 * FromRGBA:
+		 *		Converts a row of RGBA bytes (as decoded by libpng) to ARGB pixels.
+		 *		rgba and argb may be the same buffer. Uses AltiVec when both are 16 byte aligned
+		 *
+		 * rgba:
+		 *		Array of R, G, B, A bytes
+		 * argb [OUT]:
+		 *		Array of ARGB pixels
+		 * width:
+		 *		Number of pixels
+		 */
+		static void FromRGBA(const unsigned char * rgba, unsigned int * argb, int width);
+
+		/*
+		 * FromRGB:
+		 *		Converts a row of RGB bytes (as decoded by libjpeg) to opaque ARGB pixels.
+		 *		Uses AltiVec when both are 16 byte aligned
+		 *
+		 * rgb:
+		 *		Array of R, G, B bytes
+		 * argb [OUT]:
+		 *		Array of ARGB pixels (must not overlap rgb)
+		 * width:
+		 *		Number of pixels
+		 */
+		static void FromRGB(const unsigned char * rgb, unsigned int * argb, int width);
+
+		/*
+		 * Premultiply:
+		 *		Multiplies the color channels of an ARGB image by its alpha. Uses AltiVec when rows are 16 byte aligned
+		 *
+		 * argb [IN/OUT]:
+		 *		Array of ARGB pixels
+		 * width:
+		 *		Width of image
+		 * height:
+		 *		Height of image
+		 * pitch:
+		 *		Number of bytes per row
+		 */
+		static void Premultiply(unsigned int * argb, int width, int height, int pitch);
+
+	private:
+		// Pack a row of pixels into a 16 bit format
+		static void packRow16(const unsigned int * src, unsigned short * dst, int width, PixelFormat format);
+		// Convert a row of pixels to luminance
+		static void packRowL8(const unsigned int * src, unsigned char * dst, int width);
+		// Encode the 4x4 block at x,y
+		static void encodeBlock(const unsigned int * argb, int width, int height, int pitch, int x, int y, PixelFormat format, unsigned char * out);
+		// Encode 16 pixels as a DXT color block
+		static void encodeColor(const unsigned int * block, bool transparent, unsigned char * out);
+	};
+
+}
+
+#endif /* MINI2D_PIXEL_HPP_ */
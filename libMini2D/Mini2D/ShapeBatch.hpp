@@ -0,0 +1,150 @@
+/*
+ * ShapeBatch.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_SHAPEBATCH_HPP_
+#define MINI2D_SHAPEBATCH_HPP_
+
+#include <vector>                                // std::vector<>
+
+#include <Mini2D/Mini.hpp>                       // Mini class
+#include <Mini2D/Units.hpp>                      // Vector2, RectangleF, CircleF
+
+namespace Mini2D {
+
+	/*
+	 * ShapeBatch:
+	 *		Collects untextured shapes (rectangles, lines, circles, polygons and their outlines) as colored quads.
+	 *		Flush draws everything added since the last flush with one call, instead of one primitive per shape
+	 */
+	class ShapeBatch {
+	public:
+		float ZIndex;                            // Z coordinate the batch is drawn at
+
+		// Constructors
+		ShapeBatch(Mini * mini, unsigned int reserve = 256);
+		virtual ~ShapeBatch();
+
+		/*
+		 * AddRectangle:
+		 *		Adds a filled rectangle. Rotation and anchor are taken from the rectangle
+		 *
+		 * rectangle:
+		 *		Rectangle to fill
+		 * rgba:
+		 *		Color
+		 * rgbaTL, rgbaTR, rgbaBR, rgbaBL:
+		 *		Color of each corner (blended across the rectangle)
+		 */
+		void AddRectangle(RectangleF * rectangle, unsigned int rgba);
+		void AddRectangle(RectangleF * rectangle, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL);
+
+		/*
+		 * AddRectangleOutline:
+		 *		Adds the border of a rectangle, drawn inside its edges
+		 *
+		 * rectangle:
+		 *		Rectangle to outline
+		 * width:
+		 *		Width of border
+		 * rgba:
+		 *		Color
+		 */
+		void AddRectangleOutline(RectangleF * rectangle, float width, unsigned int rgba);
+
+		/*
+		 * AddLine:
+		 *		Adds a line
+		 *
+		 * start:
+		 *		First point
+		 * end:
+		 *		Second point
+		 * width:
+		 *		Width of line
+		 * rgba:
+		 *		Color
+		 * rgbaStart, rgbaEnd:
+		 *		Color at each point (blended along the line)
+		 */
+		void AddLine(Vector2 start, Vector2 end, float width, unsigned int rgba);
+		void AddLine(Vector2 start, Vector2 end, float width, unsigned int rgbaStart, unsigned int rgbaEnd);
+
+		/*
+		 * AddCircle:
+		 *		Adds a filled circle. The number of segments is picked from its radius on screen
+		 *
+		 * circle:
+		 *		Circle to fill
+		 * rgba:
+		 *		Color
+		 * rgbaCenter, rgbaEdge:
+		 *		Color at the center and along the edge (blended between them)
+		 */
+		void AddCircle(CircleF * circle, unsigned int rgba);
+		void AddCircle(CircleF * circle, unsigned int rgbaCenter, unsigned int rgbaEdge);
+
+		/*
+		 * AddCircleOutline:
+		 *		Adds the border of a circle, drawn inside its edge
+		 *
+		 * circle:
+		 *		Circle to outline
+		 * width:
+		 *		Width of border
+		 * rgba:
+		 *		Color
+		 */
+		void AddCircleOutline(CircleF * circle, float width, unsigned int rgba);
+
+		/*
+		 * AddPolygon:
+		 *		Adds a filled convex polygon
+		 *
+		 * points:
+		 *		Array of vertices in order around the polygon
+		 * count:
+		 *		Number of vertices (at least 3)
+		 * rgba:
+		 *		Color
+		 */
+		void AddPolygon(const Vector2 * points, int count, unsigned int rgba);
+
+		/*
+		 * Flush:
+		 *		Draws every shape added since the last flush as a single primitive, then clears the batch
+		 */
+		void Flush();
+
+		/*
+		 * Clear:
+		 *		Removes every shape without drawing. Memory is kept for the next frame
+		 */
+		void Clear();
+
+		/*
+		 * GetQuadCount:
+		 *		Returns the number of quads the shapes were tessellated into
+		 */
+		int GetQuadCount();
+
+	private:
+		Mini * _mini;
+
+		std::vector<float> _x, _y;               // Vertex positions (4 per quad)
+		std::vector<unsigned int> _rgba;         // Vertex colors (4 per quad)
+
+		// Append one quad. Triangles repeat their last vertex
+		void addQuad(float x0, float y0, unsigned int c0, float x1, float y1, unsigned int c1, float x2, float y2, unsigned int c2, float x3, float y3, unsigned int c3);
+		// Number of segments (even) that keeps a circle of radius within half a pixel of round on screen
+		int circleSegments(float radius);
+		// Append a ring between radius inner and outer (inner of 0 fills the circle)
+		void addRing(float x, float y, float inner, float outer, unsigned int rgbaInner, unsigned int rgbaOuter);
+	};
+
+}
+
+#endif /* MINI2D_SHAPEBATCH_HPP_ */
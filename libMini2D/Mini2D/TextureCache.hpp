@@ -0,0 +1,129 @@
+/*
+ * TextureCache.hpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#ifndef MINI2D_TEXTURECACHE_HPP_
+#define MINI2D_TEXTURECACHE_HPP_
+
+#include <map>                                   // std::map<>
+#include <vector>                                // std::vector<>
+
+#include <Mini2D/Pixel.hpp>                      // Pixel formats
+
+#define TEXTURE_MAX_MIPS    12                   // Up to 2048x2048
+
+namespace Mini2D {
+
+	class Mini;
+
+	class TextureCache {
+	public:
+		typedef struct _textureMip_t {
+			unsigned int TextureOff;             // RSX offset to level
+			int Width, Height, Pitch;            // Size of level
+		} TextureMip;
+
+		typedef struct _texture_t {
+			Pixel::PixelFormat Format;           // Format of every level
+			int MipCount;                        // Number of levels (level 0 is the full size image)
+			TextureMip Mips[TEXTURE_MAX_MIPS];   // Levels
+			void * Pointer;                      // Start of the texture heap range holding every level
+			unsigned int Size;                   // Size of the texture heap range
+		} Texture;
+
+		typedef struct _cacheEntry_t {
+			unsigned long long Key;              // Hash of source
+			int RefCount;                        // Number of holders
+			Texture Data;                        // Uploaded texture
+			TextureCache * Owner;                // Cache that frees the texture on last release. Null once detached
+		} CacheEntry;
+
+		typedef struct _textureCacheStats_t {
+			unsigned int Hits;                   // Number of Acquire calls that found an entry
+			unsigned int Misses;                 // Number of Acquire calls that did not
+			unsigned int Entries;                // Number of entries
+			unsigned int Bytes;                  // Texture heap used by entries
+		} TextureCacheStats;
+
+		// Constructors
+		TextureCache(Mini * mini);
+		virtual ~TextureCache();
+
+		/*
+		 * Hash:
+		 *		64 bit FNV-1a hash of a buffer. Chain calls by passing the previous result as seed
+		 *
+		 * data:
+		 *		Buffer to hash
+		 * size:
+		 *		Size of buffer
+		 * seed:
+		 *		Starting value
+		 */
+		static unsigned long long Hash(const void * data, unsigned int size, unsigned long long seed = 0xCBF29CE484222325ULL);
+
+		/*
+		 * Acquire:
+		 *		Finds an entry and adds a reference to it
+		 *
+		 * key:
+		 *		Hash of source
+		 *
+		 * Return:
+		 *		Entry. Null if there is none
+		 */
+		CacheEntry * Acquire(unsigned long long key);
+
+		/*
+		 * Insert:
+		 *		Adds an entry with one reference. The cache takes ownership of the texture's heap range.
+		 *		An entry already stored under key is dropped from the cache; its texture is freed now if
+		 *		nothing holds it, otherwise when its last holder releases it
+		 *
+		 * key:
+		 *		Hash of source
+		 * texture:
+		 *		Uploaded texture
+		 *
+		 * Return:
+		 *		Entry
+		 */
+		CacheEntry * Insert(unsigned long long key, const Texture& texture);
+
+		/*
+		 * Release:
+		 *		Removes a reference. The entry and its texture are freed when the last reference is released.
+		 *		Safe to call after the owning cache has been cleared or destroyed
+		 *
+		 * entry:
+		 *		Entry returned by Acquire or Insert
+		 */
+		static void Release(CacheEntry * entry);
+
+		/*
+		 * Clear:
+		 *		Forgets every entry without freeing texture memory (used when the texture heap is reset).
+		 *		Entries that are still referenced are detached and stay valid until released
+		 */
+		void Clear();
+
+		/*
+		 * GetStats:
+		 *		Returns hit and miss counts, and the number and size of entries
+		 */
+		TextureCacheStats GetStats();
+
+	private:
+		Mini * _mini;
+
+		std::map<unsigned long long, CacheEntry*> _entries;  // Entries by key
+		std::vector<CacheEntry*> _replaced;      // Entries replaced by Insert that still have holders
+		TextureCacheStats _stats;                // Counters
+	};
+
+}
+
+#endif /* MINI2D_TEXTURECACHE_HPP_ */
@@ -84,6 +84,24 @@ namespace Mini2D {
 		static float Magnitude(Vector2 * a);
 		static void Reflect(Vector2 * out, Vector2 * direction, Vector2 * normal);
 		static float ToAngle(Vector2 * in);
+
+		/*
+		 * RotateAroundPoint:
+		 *		Rotates an array of points around a point. Points are stored as separate X and Y arrays (SoA).
+		 *		If x and y are 16 byte aligned the points are processed four at a time with AltiVec.
+		 *
+		 * x [IN/OUT]:
+		 *		Array of X coordinates
+		 * y [IN/OUT]:
+		 *		Array of Y coordinates
+		 * count:
+		 *		Number of points
+		 * point:
+		 *		The X,Y position of which to rotate the points around
+		 * angle:
+		 *		The number of degrees to rotate
+		 */
+		static void RotateAroundPoint(float * x, float * y, int count, Vector2 * point, float angle);
 	};
 
 	class CircleF {
@@ -209,6 +227,44 @@ namespace Mini2D {
 		 */
 		bool Contain(RectangleF * rectangle);
 
+		/*
+		 * Overlap:
+		 *		Determines if the bounding box of the passed rectangle overlaps the bounding box of this rectangle
+		 *
+		 * rectangle:
+		 *		Rectangle to compare with
+		 *
+		 * Return:
+		 *		1 if the rectangles overlap. 0 if not.
+		 */
+		bool Overlap(RectangleF * rectangle);
+
+		/*
+		 * GetCorners:
+		 *		Calculates the rotated corners of an array of rectangles. Rectangles are stored as separate arrays (SoA).
+		 *		The corners are written in draw order (TopLeft, TopRight, BottomRight, BottomLeft) so that
+		 *		cornersX and cornersY can be passed directly to Mini::DrawTextureQuads() and Mini::DrawRectangleQuads().
+		 *		If every array is 16 byte aligned the rectangles are processed four at a time with AltiVec.
+		 *
+		 * x:
+		 *		Array of center X coordinates
+		 * y:
+		 *		Array of center Y coordinates
+		 * w:
+		 *		Array of widths
+		 * h:
+		 *		Array of heights
+		 * angle:
+		 *		Array of angles of rotation around each center (degrees). Can be null
+		 * count:
+		 *		Number of rectangles
+		 * cornersX [OUT]:
+		 *		Array of count*4 X coordinates
+		 * cornersY [OUT]:
+		 *		Array of count*4 Y coordinates
+		 */
+		static void GetCorners(const float * x, const float * y, const float * w, const float * h, const float * angle, int count, float * cornersX, float * cornersY);
+
 		// Compound Operators
 		RectangleF& operator=(const RectangleF& r);
 
@@ -0,0 +1,606 @@
+/*
+ * Pixel.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <string.h>                              // memset
+
+#ifdef __ALTIVEC__
+#include <altivec.h>                             // AltiVec intrinsics
+#undef vector                                    // Keep the C++ keywords usable
+#undef pixel
+#undef bool
+#endif
+
+#include <tiny3d.h>                              // Tiny3D texture formats
+#include <Mini2D/Pixel.hpp>                      // Class definition
+
+#define ROW(argb, pitch, y) ((const unsigned int *)((const unsigned char *)(argb) + (y) * (pitch)))
+
+namespace Mini2D {
+
+	// Shift right then mask of each channel, for packing 0xAARRGGBB into 16 bits
+	typedef struct _packTerm_t {
+		unsigned int shift;
+		unsigned int mask;
+	} PackTerm;
+
+	static const PackTerm PACK_R5G6B5[4] =   { { 8, 0xF800 }, { 5, 0x07E0 }, { 3, 0x001F }, { 0, 0x0000 } };
+	static const PackTerm PACK_A4R4G4B4[4] = { { 16, 0xF000 }, { 12, 0x0F00 }, { 8, 0x00F0 }, { 4, 0x000F } };
+	static const PackTerm PACK_A1R5G5B5[4] = { { 16, 0x8000 }, { 9, 0x7C00 }, { 6, 0x03E0 }, { 3, 0x001F } };
+
+	// Luminance weights out of 256
+	#define LUM_R 77
+	#define LUM_G 150
+	#define LUM_B 29
+
+	//---------------------------------------------------------------------------
+	// Format Functions
+	//---------------------------------------------------------------------------
+	Pixel::AlphaType Pixel::GetAlphaType(const unsigned int * argb, int width, int height, int pitch) {
+		AlphaType type = PIXEL_ALPHA_OPAQUE;
+		unsigned int a;
+		int x, y;
+
+		if (!argb)
+			return type;
+
+		for (y = 0; y < height; y++) {
+			const unsigned int * row = ROW(argb, pitch, y);
+			for (x = 0; x < width; x++) {
+				a = row[x] >> 24;
+				if (a == 0xFF)
+					continue;
+				if (a)
+					return PIXEL_ALPHA_FULL;
+				type = PIXEL_ALPHA_BINARY;
+			}
+		}
+
+		return type;
+	}
+
+	Pixel::PixelFormat Pixel::ChooseFormat(const unsigned int * argb, int width, int height, int pitch) {
+		switch (GetAlphaType(argb, width, height, pitch)) {
+			case PIXEL_ALPHA_OPAQUE:
+				return PIXEL_FORMAT_R5G6B5;
+			case PIXEL_ALPHA_BINARY:
+				return PIXEL_FORMAT_A1R5G5B5;
+			default:
+				return PIXEL_FORMAT_A8R8G8B8;
+		}
+	}
+
+	int Pixel::GetPitch(PixelFormat format, int width) {
+		switch (format) {
+			case PIXEL_FORMAT_R5G6B5:
+			case PIXEL_FORMAT_A4R4G4B4:
+			case PIXEL_FORMAT_A1R5G5B5:
+				return width * 2;
+			case PIXEL_FORMAT_L8:
+				return width;
+			case PIXEL_FORMAT_DXT1:
+				return ((width + 3) / 4) * 8;
+			case PIXEL_FORMAT_DXT3:
+			case PIXEL_FORMAT_DXT5:
+				return ((width + 3) / 4) * 16;
+			default:
+				return width * 4;
+		}
+	}
+
+	int Pixel::GetRows(PixelFormat format, int height) {
+		switch (format) {
+			case PIXEL_FORMAT_DXT1:
+			case PIXEL_FORMAT_DXT3:
+			case PIXEL_FORMAT_DXT5:
+				return (height + 3) / 4;
+			default:
+				return height;
+		}
+	}
+
+	unsigned int Pixel::GetTiny3DFormat(PixelFormat format) {
+		switch (format) {
+			case PIXEL_FORMAT_R5G6B5:
+				return TINY3D_TEX_FORMAT_R5G6B5;
+			case PIXEL_FORMAT_A4R4G4B4:
+				return TINY3D_TEX_FORMAT_A4R4G4B4;
+			case PIXEL_FORMAT_A1R5G5B5:
+				return TINY3D_TEX_FORMAT_A1R5G5B5;
+			case PIXEL_FORMAT_L8:
+				return TINY3D_TEX_FORMAT_L8;
+			case PIXEL_FORMAT_DXT1:
+				return TINY3D_TEX_FORMAT_COMPRESSED_DXT1;
+			case PIXEL_FORMAT_DXT3:
+				return TINY3D_TEX_FORMAT_COMPRESSED_DXT23;
+			case PIXEL_FORMAT_DXT5:
+				return TINY3D_TEX_FORMAT_COMPRESSED_DXT45;
+			default:
+				return TINY3D_TEX_FORMAT_A8R8G8B8;
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Convert Functions
+	//---------------------------------------------------------------------------
+	bool Pixel::Convert(const unsigned int * argb, int width, int height, int pitch, PixelFormat format, void * out) {
+		int x, y, outPitch;
+		unsigned char * dst = (unsigned char *)out;
+
+		if (!argb || !out || width <= 0 || height <= 0 || format == PIXEL_FORMAT_AUTO)
+			return 0;
+
+		outPitch = GetPitch(format, width);
+
+		switch (format) {
+			case PIXEL_FORMAT_A8R8G8B8:
+				for (y = 0; y < height; y++)
+					memcpy(dst + y * outPitch, ROW(argb, pitch, y), outPitch);
+				break;
+			case PIXEL_FORMAT_R5G6B5:
+			case PIXEL_FORMAT_A4R4G4B4:
+			case PIXEL_FORMAT_A1R5G5B5:
+				for (y = 0; y < height; y++)
+					packRow16(ROW(argb, pitch, y), (unsigned short *)(dst + y * outPitch), width, format);
+				break;
+			case PIXEL_FORMAT_L8:
+				for (y = 0; y < height; y++)
+					packRowL8(ROW(argb, pitch, y), dst + y * outPitch, width);
+				break;
+			case PIXEL_FORMAT_DXT1:
+			case PIXEL_FORMAT_DXT3:
+			case PIXEL_FORMAT_DXT5:
+				for (y = 0; y < height; y += 4) {
+					unsigned char * block = dst + (y / 4) * outPitch;
+					for (x = 0; x < width; x += 4) {
+						encodeBlock(argb, width, height, pitch, x, y, format, block);
+						block += format == PIXEL_FORMAT_DXT1 ? 8 : 16;
+					}
+				}
+				break;
+			default:
+				return 0;
+		}
+
+		return 1;
+	}
+
+	void Pixel::packRow16(const unsigned int * src, unsigned short * dst, int width, PixelFormat format) {
+		const PackTerm * terms = format == PIXEL_FORMAT_R5G6B5 ? PACK_R5G6B5 : (format == PIXEL_FORMAT_A4R4G4B4 ? PACK_A4R4G4B4 : PACK_A1R5G5B5);
+		unsigned int p;
+		int i = 0;
+
+#ifdef __ALTIVEC__
+		// Eight pixels at a time when both rows are aligned
+		if (!(((unsigned long)src | (unsigned long)dst) & 15)) {
+			__vector unsigned int s0 = (__vector unsigned int){terms[0].shift,terms[0].shift,terms[0].shift,terms[0].shift};
+			__vector unsigned int s1 = (__vector unsigned int){terms[1].shift,terms[1].shift,terms[1].shift,terms[1].shift};
+			__vector unsigned int s2 = (__vector unsigned int){terms[2].shift,terms[2].shift,terms[2].shift,terms[2].shift};
+			__vector unsigned int s3 = (__vector unsigned int){terms[3].shift,terms[3].shift,terms[3].shift,terms[3].shift};
+			__vector unsigned int m0 = (__vector unsigned int){terms[0].mask,terms[0].mask,terms[0].mask,terms[0].mask};
+			__vector unsigned int m1 = (__vector unsigned int){terms[1].mask,terms[1].mask,terms[1].mask,terms[1].mask};
+			__vector unsigned int m2 = (__vector unsigned int){terms[2].mask,terms[2].mask,terms[2].mask,terms[2].mask};
+			__vector unsigned int m3 = (__vector unsigned int){terms[3].mask,terms[3].mask,terms[3].mask,terms[3].mask};
+			__vector unsigned int a, b;
+
+			for (; (i+8) <= width; i += 8) {
+				a = vec_ld(0, src+i);
+				b = vec_ld(16, src+i);
+
+				a = vec_or(vec_or(vec_and(vec_sr(a, s0), m0), vec_and(vec_sr(a, s1), m1)),
+						vec_or(vec_and(vec_sr(a, s2), m2), vec_and(vec_sr(a, s3), m3)));
+				b = vec_or(vec_or(vec_and(vec_sr(b, s0), m0), vec_and(vec_sr(b, s1), m1)),
+						vec_or(vec_and(vec_sr(b, s2), m2), vec_and(vec_sr(b, s3), m3)));
+
+				// Every lane fits in 16 bits so the modulo pack is exact
+				vec_st(vec_pack(a, b), 0, dst+i);
+			}
+		}
+#endif
+
+		for (; i < width; i++) {
+			p = src[i];
+			dst[i] = (unsigned short)(((p >> terms[0].shift) & terms[0].mask) | ((p >> terms[1].shift) & terms[1].mask) |
+							((p >> terms[2].shift) & terms[2].mask) | ((p >> terms[3].shift) & terms[3].mask));
+		}
+	}
+
+	void Pixel::packRowL8(const unsigned int * src, unsigned char * dst, int width) {
+		unsigned int p;
+		int i = 0;
+
+#ifdef __ALTIVEC__
+		// Sixteen pixels at a time when both rows are aligned
+		if (!(((unsigned long)src | (unsigned long)dst) & 15)) {
+			__vector unsigned int vByte = (__vector unsigned int){0xFF,0xFF,0xFF,0xFF};
+			__vector unsigned int v8 = (__vector unsigned int){8,8,8,8};
+			__vector unsigned int v16 = (__vector unsigned int){16,16,16,16};
+			__vector float vR = (__vector float){LUM_R/256.f,LUM_R/256.f,LUM_R/256.f,LUM_R/256.f};
+			__vector float vG = (__vector float){LUM_G/256.f,LUM_G/256.f,LUM_G/256.f,LUM_G/256.f};
+			__vector float vB = (__vector float){LUM_B/256.f,LUM_B/256.f,LUM_B/256.f,LUM_B/256.f};
+			__vector float vRound = (__vector float){0.5f,0.5f,0.5f,0.5f};
+			__vector unsigned int l[4], p4;
+			__vector float lum;
+			int k;
+
+			for (; (i+16) <= width; i += 16) {
+				for (k = 0; k < 4; k++) {
+					p4 = vec_ld(k*16, src+i);
+					lum = vec_madd(vec_ctf(vec_and(vec_sr(p4, v16), vByte), 0), vR, vRound);
+					lum = vec_madd(vec_ctf(vec_and(vec_sr(p4, v8), vByte), 0), vG, lum);
+					lum = vec_madd(vec_ctf(vec_and(p4, vByte), 0), vB, lum);
+					l[k] = vec_ctu(lum, 0);
+				}
+
+				vec_st(vec_pack(vec_pack(l[0], l[1]), vec_pack(l[2], l[3])), 0, dst+i);
+			}
+		}
+#endif
+
+		for (; i < width; i++) {
+			p = src[i];
+			dst[i] = (unsigned char)((((p >> 16) & 0xFF) * LUM_R + ((p >> 8) & 0xFF) * LUM_G + (p & 0xFF) * LUM_B + 128) >> 8);
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Downsample Functions
+	//---------------------------------------------------------------------------
+	// Per byte average, rounding up (same as vec_avg)
+	static inline unsigned int avg4x8(unsigned int a, unsigned int b) {
+		return (a | b) - (((a ^ b) >> 1) & 0x7F7F7F7F);
+	}
+
+	void Pixel::Downsample(const unsigned int * argb, int width, int height, int pitch, unsigned int * out, int outPitch) {
+		int x, y, outW, outH;
+		const unsigned int * r0, * r1;
+		unsigned int * dst;
+
+		if (!argb || !out || width <= 0 || height <= 0)
+			return;
+
+		outW = width > 1 ? width / 2 : 1;
+		outH = height > 1 ? height / 2 : 1;
+
+		for (y = 0; y < outH; y++) {
+			r0 = ROW(argb, pitch, y*2);
+			r1 = ROW(argb, pitch, height > 1 ? y*2+1 : y*2);
+			dst = (unsigned int *)((unsigned char *)out + y * outPitch);
+			x = 0;
+
+#ifdef __ALTIVEC__
+			// Four output pixels from eight input pixels of each row
+			if (width > 1 && !(((unsigned long)r0 | (unsigned long)r1 | (unsigned long)dst) & 15)) {
+				__vector unsigned char even = (__vector unsigned char){0,1,2,3, 8,9,10,11, 16,17,18,19, 24,25,26,27};
+				__vector unsigned char odd = (__vector unsigned char){4,5,6,7, 12,13,14,15, 20,21,22,23, 28,29,30,31};
+				__vector unsigned char a, b;
+
+				for (; (x+4) <= outW; x += 4) {
+					a = vec_avg((__vector unsigned char)vec_ld(0, r0+x*2), (__vector unsigned char)vec_ld(0, r1+x*2));
+					b = vec_avg((__vector unsigned char)vec_ld(16, r0+x*2), (__vector unsigned char)vec_ld(16, r1+x*2));
+					vec_st(vec_avg(vec_perm(a, b, even), vec_perm(a, b, odd)), 0, (unsigned char *)(dst+x));
+				}
+			}
+#endif
+
+			// Average vertically then horizontally so the result matches the vector path
+			for (; x < outW; x++) {
+				int x0 = x*2, x1 = width > 1 ? x*2+1 : x*2;
+				dst[x] = avg4x8(avg4x8(r0[x0], r1[x0]), avg4x8(r0[x1], r1[x1]));
+			}
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// Decode Functions
+	//---------------------------------------------------------------------------
+	void Pixel::FromRGBA(const unsigned char * rgba, unsigned int * argb, int width) {
+		int x = 0;
+
+		if (!rgba || !argb)
+			return;
+
+#ifdef __ALTIVEC__
+		// Rotate each pixel's bytes right by one
+		if (!(((unsigned long)rgba | (unsigned long)argb) & 15)) {
+			__vector unsigned char swizzle = (__vector unsigned char){3,0,1,2, 7,4,5,6, 11,8,9,10, 15,12,13,14};
+
+			for (; (x+4) <= width; x += 4)
+				vec_st(vec_perm(vec_ld(0, rgba+x*4), vec_ld(0, rgba+x*4), swizzle), 0, (unsigned char *)(argb+x));
+		}
+#endif
+
+		// Read the whole pixel before writing so rgba and argb can be the same buffer
+		for (; x < width; x++) {
+			const unsigned char * p = rgba + x*4;
+			argb[x] = ((unsigned int)p[3] << 24) | ((unsigned int)p[0] << 16) | ((unsigned int)p[1] << 8) | p[2];
+		}
+	}
+
+	void Pixel::FromRGB(const unsigned char * rgb, unsigned int * argb, int width) {
+		int x = 0;
+
+		if (!rgb || !argb)
+			return;
+
+#ifdef __ALTIVEC__
+		// Sixteen pixels from three vectors of RGB bytes. Byte 0 of every pixel is filled by the alpha mask
+		if (!(((unsigned long)rgb | (unsigned long)argb) & 15)) {
+			__vector unsigned char p0 = (__vector unsigned char){0,0,1,2, 0,3,4,5, 0,6,7,8, 0,9,10,11};
+			__vector unsigned char p1 = (__vector unsigned char){0,12,13,14, 0,15,16,17, 0,18,19,20, 0,21,22,23};
+			__vector unsigned char p2 = (__vector unsigned char){0,8,9,10, 0,11,12,13, 0,14,15,16, 0,17,18,19};
+			__vector unsigned char p3 = (__vector unsigned char){0,4,5,6, 0,7,8,9, 0,10,11,12, 0,13,14,15};
+			__vector unsigned char alpha = (__vector unsigned char){255,0,0,0, 255,0,0,0, 255,0,0,0, 255,0,0,0};
+			__vector unsigned char a, b, c;
+			unsigned char * dst;
+
+			for (; (x+16) <= width; x += 16) {
+				a = vec_ld(0, rgb+x*3);
+				b = vec_ld(16, rgb+x*3);
+				c = vec_ld(32, rgb+x*3);
+				dst = (unsigned char *)(argb+x);
+				vec_st(vec_or(vec_perm(a, b, p0), alpha), 0, dst);
+				vec_st(vec_or(vec_perm(a, b, p1), alpha), 16, dst);
+				vec_st(vec_or(vec_perm(b, c, p2), alpha), 32, dst);
+				vec_st(vec_or(vec_perm(c, c, p3), alpha), 48, dst);
+			}
+		}
+#endif
+
+		for (; x < width; x++) {
+			const unsigned char * p = rgb + x*3;
+			argb[x] = 0xFF000000 | ((unsigned int)p[0] << 16) | ((unsigned int)p[1] << 8) | p[2];
+		}
+	}
+
+	// c * a / 255, rounded to nearest (same as the vector path)
+	static inline unsigned int mul255(unsigned int c, unsigned int a) {
+		unsigned int t = c * a + 128;
+		return (t + (t >> 8)) >> 8;
+	}
+
+	void Pixel::Premultiply(unsigned int * argb, int width, int height, int pitch) {
+		unsigned int * row, p, a;
+		int x, y;
+
+		if (!argb)
+			return;
+
+		for (y = 0; y < height; y++) {
+			row = (unsigned int *)((unsigned char *)argb + y * pitch);
+			x = 0;
+
+#ifdef __ALTIVEC__
+			if (!((unsigned long)row & 15)) {
+				__vector unsigned char splat = (__vector unsigned char){0,0,0,0, 4,4,4,4, 8,8,8,8, 12,12,12,12};
+				__vector unsigned char merge = (__vector unsigned char){1,17,3,19, 5,21,7,23, 9,25,11,27, 13,29,15,31};
+				__vector unsigned char keep = (__vector unsigned char){255,0,0,0, 255,0,0,0, 255,0,0,0, 255,0,0,0};
+				__vector unsigned short round = vec_splat_u16(8), shift = vec_splat_u16(8);
+				__vector unsigned char v, alpha;
+				__vector unsigned short even, odd;
+
+				// 128 does not fit a splat immediate
+				round = vec_sl(round, vec_splat_u16(4));
+
+				for (; (x+4) <= width; x += 4) {
+					v = vec_ld(0, (unsigned char *)(row+x));
+					alpha = vec_perm(v, v, splat);
+
+					even = vec_add(vec_mule(v, alpha), round);
+					odd = vec_add(vec_mulo(v, alpha), round);
+					even = vec_sr(vec_add(even, vec_sr(even, shift)), shift);
+					odd = vec_sr(vec_add(odd, vec_sr(odd, shift)), shift);
+
+					vec_st(vec_sel(vec_perm((__vector unsigned char)even, (__vector unsigned char)odd, merge), v, keep), 0, (unsigned char *)(row+x));
+				}
+			}
+#endif
+
+			for (; x < width; x++) {
+				p = row[x];
+				a = p >> 24;
+				row[x] = (p & 0xFF000000) | (mul255((p >> 16) & 0xFF, a) << 16) | (mul255((p >> 8) & 0xFF, a) << 8) | mul255(p & 0xFF, a);
+			}
+		}
+	}
+
+	//---------------------------------------------------------------------------
+	// DXT Functions
+	//---------------------------------------------------------------------------
+	static unsigned short to565(int r, int g, int b) {
+		return (unsigned short)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+	}
+
+	static void from565(unsigned short c, int * rgb) {
+		int r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+
+	static void writeLE16(unsigned char * out, unsigned int v) {
+		out[0] = v & 0xFF;
+		out[1] = (v >> 8) & 0xFF;
+	}
+
+	void Pixel::encodeBlock(const unsigned int * argb, int width, int height, int pitch, int x, int y, PixelFormat format, unsigned char * out) {
+		unsigned int block[16];
+		int i, j, k, a, a0, a1, best, dist, bestDist, palette[8];
+		bool transparent = 0;
+		unsigned long long bits;
+
+		// Gather the block, repeating the last row/column past the edge of the image
+		for (j = 0; j < 4; j++)
+			for (i = 0; i < 4; i++)
+				block[j*4+i] = ROW(argb, pitch, (y+j) < height ? (y+j) : (height-1))[(x+i) < width ? (x+i) : (width-1)];
+
+		switch (format) {
+			case PIXEL_FORMAT_DXT1:
+				for (i = 0; i < 16; i++)
+					if ((block[i] >> 24) < 128)
+						transparent = 1;
+				encodeColor(block, transparent, out);
+				break;
+			case PIXEL_FORMAT_DXT3:
+				// 4 bits of alpha per pixel
+				memset(out, 0, 8);
+				for (i = 0; i < 16; i++)
+					out[i/2] |= ((block[i] >> 28) & 0xF) << ((i & 1) * 4);
+				encodeColor(block, 0, out + 8);
+				break;
+			case PIXEL_FORMAT_DXT5:
+				a0 = 0;
+				a1 = 255;
+				for (i = 0; i < 16; i++) {
+					a = block[i] >> 24;
+					if (a > a0) a0 = a;
+					if (a < a1) a1 = a;
+				}
+
+				// Eight alpha levels between the endpoints
+				palette[0] = a0;
+				palette[1] = a1;
+				for (k = 2; k < 8; k++)
+					palette[k] = ((8-k) * a0 + (k-1) * a1) / 7;
+
+				bits = 0;
+				if (a0 != a1) {
+					for (i = 0; i < 16; i++) {
+						a = block[i] >> 24;
+						best = 0;
+						bestDist = 256;
+						for (k = 0; k < 8; k++) {
+							dist = a > palette[k] ? a - palette[k] : palette[k] - a;
+							if (dist < bestDist) {
+								bestDist = dist;
+								best = k;
+							}
+						}
+						bits |= (unsigned long long)best << (i * 3);
+					}
+				}
+
+				out[0] = a0;
+				out[1] = a1;
+				for (k = 0; k < 6; k++)
+					out[2+k] = (bits >> (k * 8)) & 0xFF;
+
+				encodeColor(block, 0, out + 8);
+				break;
+			default:
+				break;
+		}
+	}
+
+	void Pixel::encodeColor(const unsigned int * block, bool transparent, unsigned char * out) {
+		int i, k, c, count = 0, best, dist, bestDist, colors;
+		int minC[3] = { 255, 255, 255 }, maxC[3] = { 0, 0, 0 }, mean[3] = { 0, 0, 0 }, rgb[3];
+		int covG = 0, covB = 0, covGB = 0, palette[4][3];
+		unsigned short c0, c1, t;
+		unsigned int indices = 0;
+
+		// Bounding box of the opaque pixels
+		for (i = 0; i < 16; i++) {
+			if (transparent && (block[i] >> 24) < 128)
+				continue;
+
+			for (k = 0; k < 3; k++) {
+				c = (block[i] >> (16 - k*8)) & 0xFF;
+				if (c < minC[k]) minC[k] = c;
+				if (c > maxC[k]) maxC[k] = c;
+				mean[k] += c;
+			}
+			count++;
+		}
+
+		if (!count) {
+			// Every pixel is transparent
+			writeLE16(out, 0);
+			writeLE16(out + 2, 0);
+			out[4] = out[5] = out[6] = out[7] = 0xFF;
+			return;
+		}
+
+		// Pick the diagonal of the box that follows the colors. Flip green/blue when they fall as red rises
+		for (k = 0; k < 3; k++)
+			mean[k] /= count;
+		for (i = 0; i < 16; i++) {
+			if (transparent && (block[i] >> 24) < 128)
+				continue;
+
+			rgb[0] = ((block[i] >> 16) & 0xFF) - mean[0];
+			rgb[1] = ((block[i] >> 8) & 0xFF) - mean[1];
+			rgb[2] = (block[i] & 0xFF) - mean[2];
+			covG += rgb[0] * rgb[1];
+			covB += rgb[0] * rgb[2];
+			covGB += rgb[1] * rgb[2];
+		}
+		if (maxC[0] == minC[0])
+			covB = covGB;
+		if (covG < 0) {
+			c = minC[1]; minC[1] = maxC[1]; maxC[1] = c;
+		}
+		if (covB < 0) {
+			c = minC[2]; minC[2] = maxC[2]; maxC[2] = c;
+		}
+
+		c0 = to565(maxC[0], maxC[1], maxC[2]);
+		c1 = to565(minC[0], minC[1], minC[2]);
+
+		// Four colors needs c0 > c1, three colors and transparency needs c0 <= c1
+		if (transparent ? (c0 > c1) : (c0 < c1)) {
+			t = c0; c0 = c1; c1 = t;
+		}
+
+		from565(c0, palette[0]);
+		from565(c1, palette[1]);
+		for (k = 0; k < 3; k++) {
+			if (transparent) {
+				palette[2][k] = (palette[0][k] + palette[1][k]) / 2;
+				palette[3][k] = 0;
+			}
+			else {
+				palette[2][k] = (2*palette[0][k] + palette[1][k]) / 3;
+				palette[3][k] = (palette[0][k] + 2*palette[1][k]) / 3;
+			}
+		}
+		colors = transparent ? 3 : 4;
+
+		if (c0 != c1 || transparent) {
+			for (i = 0; i < 16; i++) {
+				if (transparent && (block[i] >> 24) < 128) {
+					indices |= 3u << (i * 2);
+					continue;
+				}
+
+				rgb[0] = (block[i] >> 16) & 0xFF;
+				rgb[1] = (block[i] >> 8) & 0xFF;
+				rgb[2] = block[i] & 0xFF;
+
+				best = 0;
+				bestDist = 0x7FFFFFFF;
+				for (c = 0; c < colors; c++) {
+					dist = (rgb[0]-palette[c][0])*(rgb[0]-palette[c][0]) +
+							(rgb[1]-palette[c][1])*(rgb[1]-palette[c][1]) +
+							(rgb[2]-palette[c][2])*(rgb[2]-palette[c][2]);
+					if (dist < bestDist) {
+						bestDist = dist;
+						best = c;
+					}
+				}
+				indices |= (unsigned int)best << (i * 2);
+			}
+		}
+
+		// DXT blocks are little endian
+		writeLE16(out, c0);
+		writeLE16(out + 2, c1);
+		writeLE16(out + 4, indices & 0xFFFF);
+		writeLE16(out + 6, indices >> 16);
+	}
+
+}
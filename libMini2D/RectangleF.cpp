@@ -9,10 +9,25 @@
 #include <math.h>                                // Trig functions
 #include <stdio.h>                               // printf()
 
+#ifdef __ALTIVEC__
+#include <altivec.h>                             // AltiVec intrinsics
+#undef vector                                    // Keep the C++ keywords usable
+#undef pixel
+#undef bool
+#endif
+
 #include <Mini2D/Units.hpp>                      // Class definition
 
+#define PI 3.14159265
+#define DEG2RAD(x) ((x*PI)/180.0)
+
 namespace Mini2D {
 
+#ifdef __ALTIVEC__
+	// Sine and cosine of four angles (radians)
+	static void vecSinCos(__vector float a, __vector float * s, __vector float * c);
+#endif
+
 	//---------------------------------------------------------------------------
 	// Init Functions
 	//---------------------------------------------------------------------------
@@ -163,6 +178,168 @@ namespace Mini2D {
 		return 0;
 	}
 
+	bool RectangleF::Overlap(RectangleF * rectangle) {
+		float minX, minY, maxX, maxY;
+
+		update();
+		rectangle->GetRotatedCenter();
+
+		minX = fmin(fmin(rectangle->TopLeft.X, rectangle->TopRight.X), fmin(rectangle->BottomLeft.X, rectangle->BottomRight.X));
+		maxX = fmax(fmax(rectangle->TopLeft.X, rectangle->TopRight.X), fmax(rectangle->BottomLeft.X, rectangle->BottomRight.X));
+		minY = fmin(fmin(rectangle->TopLeft.Y, rectangle->TopRight.Y), fmin(rectangle->BottomLeft.Y, rectangle->BottomRight.Y));
+		maxY = fmax(fmax(rectangle->TopLeft.Y, rectangle->TopRight.Y), fmax(rectangle->BottomLeft.Y, rectangle->BottomRight.Y));
+
+		if (maxX < fmin(fmin(TopLeft.X, TopRight.X), fmin(BottomLeft.X, BottomRight.X)) ||
+			minX > fmax(fmax(TopLeft.X, TopRight.X), fmax(BottomLeft.X, BottomRight.X)) ||
+			maxY < fmin(fmin(TopLeft.Y, TopRight.Y), fmin(BottomLeft.Y, BottomRight.Y)) ||
+			minY > fmax(fmax(TopLeft.Y, TopRight.Y), fmax(BottomLeft.Y, BottomRight.Y)))
+			return 0;
+
+		return 1;
+	}
+
+	//---------------------------------------------------------------------------
+	// Batch Functions
+	//---------------------------------------------------------------------------
+	void RectangleF::GetCorners(const float * x, const float * y, const float * w, const float * h, const float * angle, int count, float * cornersX, float * cornersY) {
+		int i = 0;
+		float c, s, a, b, d, e;
+
+		if (!x || !y || !w || !h || !cornersX || !cornersY || count <= 0)
+			return;
+
+#ifdef __ALTIVEC__
+		// Process four rectangles at a time when every array is aligned
+		if (!(((unsigned long)x | (unsigned long)y | (unsigned long)w | (unsigned long)h |
+			(unsigned long)angle | (unsigned long)cornersX | (unsigned long)cornersY) & 15)) {
+			__vector float vHalf = (__vector float){0.5f,0.5f,0.5f,0.5f};
+			__vector float vDeg = (__vector float){PI/180.0,PI/180.0,PI/180.0,PI/180.0};
+			__vector float vZero = (__vector float){0,0,0,0};
+			__vector float vOne = (__vector float){1,1,1,1};
+			__vector float vx, vy, vw, vh, vc, vs, va, vb, vd, ve;
+			__vector float tl, tr, br, bl, t0, t1, t2, t3;
+
+			for (; (i+4) <= count; i += 4) {
+				vx = vec_ld(0, x+i);
+				vy = vec_ld(0, y+i);
+				vw = vec_madd(vec_ld(0, w+i), vHalf, vZero);
+				vh = vec_madd(vec_ld(0, h+i), vHalf, vZero);
+
+				if (angle)
+					vecSinCos(vec_madd(vec_ld(0, angle+i), vDeg, vZero), &vs, &vc);
+				else {
+					vs = vZero;
+					vc = vOne;
+				}
+
+				va = vec_madd(vw, vc, vZero);    // hw*cos
+				vb = vec_madd(vh, vs, vZero);    // hh*sin
+				vd = vec_madd(vw, vs, vZero);    // hw*sin
+				ve = vec_madd(vh, vc, vZero);    // hh*cos
+
+				// X of each corner for the four rectangles
+				tl = vec_add(vx, vec_sub(vb, va));
+				tr = vec_add(vx, vec_add(va, vb));
+				br = vec_add(vx, vec_sub(va, vb));
+				bl = vec_sub(vec_sub(vx, va), vb);
+
+				// Transpose so that each rectangle's corners are contiguous
+				t0 = vec_mergeh(tl, br);
+				t1 = vec_mergeh(tr, bl);
+				t2 = vec_mergel(tl, br);
+				t3 = vec_mergel(tr, bl);
+				vec_st(vec_mergeh(t0, t1), 0, cornersX+i*4);
+				vec_st(vec_mergel(t0, t1), 16, cornersX+i*4);
+				vec_st(vec_mergeh(t2, t3), 32, cornersX+i*4);
+				vec_st(vec_mergel(t2, t3), 48, cornersX+i*4);
+
+				// Y of each corner for the four rectangles
+				tl = vec_sub(vec_sub(vy, ve), vd);
+				tr = vec_add(vy, vec_sub(vd, ve));
+				br = vec_add(vy, vec_add(ve, vd));
+				bl = vec_add(vy, vec_sub(ve, vd));
+
+				t0 = vec_mergeh(tl, br);
+				t1 = vec_mergeh(tr, bl);
+				t2 = vec_mergel(tl, br);
+				t3 = vec_mergel(tr, bl);
+				vec_st(vec_mergeh(t0, t1), 0, cornersY+i*4);
+				vec_st(vec_mergel(t0, t1), 16, cornersY+i*4);
+				vec_st(vec_mergeh(t2, t3), 32, cornersY+i*4);
+				vec_st(vec_mergel(t2, t3), 48, cornersY+i*4);
+			}
+		}
+#endif
+
+		// Scalar fallback and remainder
+		for (; i < count; i++) {
+			c = 1;
+			s = 0;
+			if (angle && angle[i]) {
+				c = cos(DEG2RAD(angle[i]));
+				s = sin(DEG2RAD(angle[i]));
+			}
+
+			a = (w[i]/2)*c;
+			b = (h[i]/2)*s;
+			d = (w[i]/2)*s;
+			e = (h[i]/2)*c;
+
+			cornersX[i*4+0] = x[i] - a + b;
+			cornersY[i*4+0] = y[i] - e - d;
+			cornersX[i*4+1] = x[i] + a + b;
+			cornersY[i*4+1] = y[i] - e + d;
+			cornersX[i*4+2] = x[i] + a - b;
+			cornersY[i*4+2] = y[i] + e + d;
+			cornersX[i*4+3] = x[i] - a - b;
+			cornersY[i*4+3] = y[i] + e - d;
+		}
+	}
+
+#ifdef __ALTIVEC__
+	static __vector float vecSin(__vector float a) {
+		__vector float vZero = (__vector float){0,0,0,0};
+		__vector float vPi = (__vector float){PI,PI,PI,PI};
+		__vector float vHalfPi = (__vector float){PI/2,PI/2,PI/2,PI/2};
+		__vector float vNegHalfPi = (__vector float){-PI/2,-PI/2,-PI/2,-PI/2};
+		__vector float a2, p;
+
+		// Fold [-PI,PI] into [-PI/2,PI/2]
+		a = vec_sel(a, vec_sub(vPi, a), vec_cmpgt(a, vHalfPi));
+		a = vec_sel(a, vec_sub(vec_sub(vZero, vPi), a), vec_cmplt(a, vNegHalfPi));
+
+		// Taylor series to x^11
+		a2 = vec_madd(a, a, vZero);
+		p = (__vector float){-2.5052108e-8f,-2.5052108e-8f,-2.5052108e-8f,-2.5052108e-8f};
+		p = vec_madd(p, a2, (__vector float){2.7557319e-6f,2.7557319e-6f,2.7557319e-6f,2.7557319e-6f});
+		p = vec_madd(p, a2, (__vector float){-1.9841270e-4f,-1.9841270e-4f,-1.9841270e-4f,-1.9841270e-4f});
+		p = vec_madd(p, a2, (__vector float){8.3333333e-3f,8.3333333e-3f,8.3333333e-3f,8.3333333e-3f});
+		p = vec_madd(p, a2, (__vector float){-1.6666667e-1f,-1.6666667e-1f,-1.6666667e-1f,-1.6666667e-1f});
+		p = vec_madd(p, a2, (__vector float){1,1,1,1});
+
+		return vec_madd(p, a, vZero);
+	}
+
+	static void vecSinCos(__vector float a, __vector float * s, __vector float * c) {
+		__vector float vTwoPi = (__vector float){2*PI,2*PI,2*PI,2*PI};
+		__vector float vInvTwoPi = (__vector float){1/(2*PI),1/(2*PI),1/(2*PI),1/(2*PI)};
+		__vector float vPi = (__vector float){PI,PI,PI,PI};
+		__vector float vHalfPi = (__vector float){PI/2,PI/2,PI/2,PI/2};
+		__vector float vZero = (__vector float){0,0,0,0};
+		__vector float b;
+
+		// Wrap into [-PI,PI]
+		a = vec_nmsub(vec_round(vec_madd(a, vInvTwoPi, vZero)), vTwoPi, a);
+
+		// cos(a) = sin(a + PI/2)
+		b = vec_add(a, vHalfPi);
+		b = vec_sel(b, vec_sub(b, vTwoPi), vec_cmpgt(b, vPi));
+
+		*s = vecSin(a);
+		*c = vecSin(b);
+	}
+#endif
+
 	//---------------------------------------------------------------------------
 	// Compound Assignment Operator Overloads
 	//---------------------------------------------------------------------------
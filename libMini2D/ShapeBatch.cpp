@@ -0,0 +1,240 @@
+/*
+ * ShapeBatch.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <math.h>                                // Trig functions
+
+#include <Mini2D/ShapeBatch.hpp>                 // Class definition
+
+#define SEGMENTS_MIN       8
+#define SEGMENTS_MAX       256
+#define SEGMENTS_ERROR     0.5f                  // Largest distance (pixels) between a segment and the true edge
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	ShapeBatch::ShapeBatch(Mini * mini, unsigned int reserve) : _mini(mini) {
+		ZIndex = 0;
+		_x.reserve(reserve * 4);
+		_y.reserve(reserve * 4);
+		_rgba.reserve(reserve * 4);
+	}
+
+	ShapeBatch::~ShapeBatch() {
+		Clear();
+		_mini = NULL;
+	}
+
+	//---------------------------------------------------------------------------
+	// Shape Functions
+	//---------------------------------------------------------------------------
+	void ShapeBatch::AddRectangle(RectangleF * rectangle, unsigned int rgba) {
+		AddRectangle(rectangle, rgba, rgba, rgba, rgba);
+	}
+
+	void ShapeBatch::AddRectangle(RectangleF * rectangle, unsigned int rgbaTL, unsigned int rgbaTR, unsigned int rgbaBR, unsigned int rgbaBL) {
+		if (!rectangle)
+			return;
+
+		// Updates the corners
+		rectangle->GetRotatedCenter();
+
+		addQuad(rectangle->TopLeft.X, rectangle->TopLeft.Y, rgbaTL,
+			rectangle->TopRight.X, rectangle->TopRight.Y, rgbaTR,
+			rectangle->BottomRight.X, rectangle->BottomRight.Y, rgbaBR,
+			rectangle->BottomLeft.X, rectangle->BottomLeft.Y, rgbaBL);
+	}
+
+	void ShapeBatch::AddRectangleOutline(RectangleF * rectangle, float width, unsigned int rgba) {
+		float w, h, ax, ay, bx, by, ix[4], iy[4];
+
+		if (!rectangle || width <= 0)
+			return;
+
+		w = fabs(rectangle->W());
+		h = fabs(rectangle->H());
+		if (w <= 0 || h <= 0)
+			return;
+
+		// A border that meets in the middle is a filled rectangle
+		if (width * 2 >= w || width * 2 >= h) {
+			AddRectangle(rectangle, rgba);
+			return;
+		}
+
+		rectangle->GetRotatedCenter();
+		Vector2& tl = rectangle->TopLeft;
+		Vector2& tr = rectangle->TopRight;
+		Vector2& br = rectangle->BottomRight;
+		Vector2& bl = rectangle->BottomLeft;
+
+		// Steps of width along the (rotated) horizontal and vertical edges
+		ax = (tr.X - tl.X) / w * width;
+		ay = (tr.Y - tl.Y) / w * width;
+		bx = (bl.X - tl.X) / h * width;
+		by = (bl.Y - tl.Y) / h * width;
+
+		// Inner corners (TopLeft, TopRight, BottomRight, BottomLeft)
+		ix[0] = tl.X + ax + bx; iy[0] = tl.Y + ay + by;
+		ix[1] = tr.X - ax + bx; iy[1] = tr.Y - ay + by;
+		ix[2] = br.X - ax - bx; iy[2] = br.Y - ay - by;
+		ix[3] = bl.X + ax - bx; iy[3] = bl.Y + ay - by;
+
+		addQuad(tl.X, tl.Y, rgba, tr.X, tr.Y, rgba, ix[1], iy[1], rgba, ix[0], iy[0], rgba);
+		addQuad(tr.X, tr.Y, rgba, br.X, br.Y, rgba, ix[2], iy[2], rgba, ix[1], iy[1], rgba);
+		addQuad(br.X, br.Y, rgba, bl.X, bl.Y, rgba, ix[3], iy[3], rgba, ix[2], iy[2], rgba);
+		addQuad(bl.X, bl.Y, rgba, tl.X, tl.Y, rgba, ix[0], iy[0], rgba, ix[3], iy[3], rgba);
+	}
+
+	void ShapeBatch::AddLine(Vector2 start, Vector2 end, float width, unsigned int rgba) {
+		AddLine(start, end, width, rgba, rgba);
+	}
+
+	void ShapeBatch::AddLine(Vector2 start, Vector2 end, float width, unsigned int rgbaStart, unsigned int rgbaEnd) {
+		float dx = end.X - start.X, dy = end.Y - start.Y, length = sqrtf(dx*dx + dy*dy), nx, ny;
+
+		if (length <= 0 || width <= 0)
+			return;
+
+		// Half width along the normal
+		nx = -dy / length * width / 2;
+		ny = dx / length * width / 2;
+
+		addQuad(start.X + nx, start.Y + ny, rgbaStart,
+			end.X + nx, end.Y + ny, rgbaEnd,
+			end.X - nx, end.Y - ny, rgbaEnd,
+			start.X - nx, start.Y - ny, rgbaStart);
+	}
+
+	void ShapeBatch::AddCircle(CircleF * circle, unsigned int rgba) {
+		AddCircle(circle, rgba, rgba);
+	}
+
+	void ShapeBatch::AddCircle(CircleF * circle, unsigned int rgbaCenter, unsigned int rgbaEdge) {
+		Vector2 * center;
+
+		if (!circle || circle->R() <= 0)
+			return;
+
+		center = circle->GetRotatedCenter();
+		addRing(center->X, center->Y, 0, circle->R(), rgbaCenter, rgbaEdge);
+	}
+
+	void ShapeBatch::AddCircleOutline(CircleF * circle, float width, unsigned int rgba) {
+		Vector2 * center;
+
+		if (!circle || circle->R() <= 0 || width <= 0)
+			return;
+
+		center = circle->GetRotatedCenter();
+		addRing(center->X, center->Y, fmax(circle->R() - width, 0), circle->R(), rgba, rgba);
+	}
+
+	void ShapeBatch::AddPolygon(const Vector2 * points, int count, unsigned int rgba) {
+		int i;
+
+		if (!points || count < 3)
+			return;
+
+		// Fan from the first vertex, two triangles per quad. A leftover triangle repeats its last vertex
+		for (i = 1; i + 1 < count; i += 2) {
+			const Vector2& c = points[i + 2 < count ? i + 2 : i + 1];
+			addQuad(points[0].X, points[0].Y, rgba,
+				points[i].X, points[i].Y, rgba,
+				points[i + 1].X, points[i + 1].Y, rgba,
+				c.X, c.Y, rgba);
+		}
+	}
+
+	void ShapeBatch::addRing(float x, float y, float inner, float outer, unsigned int rgbaInner, unsigned int rgbaOuter) {
+		int i, segments = circleSegments(outer);
+		float step = 2 * M_PI / segments, c = cosf(step), s = sinf(step), dx = 1, dy = 0, px, py, t;
+
+		// Walk the unit circle by rotating the previous direction instead of calling sin and cos per vertex
+		if (inner <= 0) {
+			// Fan from the center, two segments per quad
+			for (i = 0; i < segments; i += 2) {
+				px = dx;
+				py = dy;
+				t = dx;
+				dx = t * c - dy * s;
+				dy = t * s + dy * c;
+
+				addQuad(x, y, rgbaInner,
+					x + px * outer, y + py * outer, rgbaOuter,
+					x + dx * outer, y + dy * outer, rgbaOuter,
+					x + (dx * c - dy * s) * outer, y + (dx * s + dy * c) * outer, rgbaOuter);
+
+				t = dx;
+				dx = t * c - dy * s;
+				dy = t * s + dy * c;
+			}
+			return;
+		}
+
+		for (i = 0; i < segments; i++) {
+			px = dx;
+			py = dy;
+			t = dx;
+			dx = t * c - dy * s;
+			dy = t * s + dy * c;
+
+			addQuad(x + px * outer, y + py * outer, rgbaOuter,
+				x + dx * outer, y + dy * outer, rgbaOuter,
+				x + dx * inner, y + dy * inner, rgbaInner,
+				x + px * inner, y + py * inner, rgbaInner);
+		}
+	}
+
+	int ShapeBatch::circleSegments(float radius) {
+		float r = radius * (_mini ? _mini->GetDrawScale() : 1);
+		int segments = SEGMENTS_MIN;
+
+		// Each segment's chord stays within SEGMENTS_ERROR of the arc
+		if (r > SEGMENTS_ERROR)
+			segments = (int)ceilf(M_PI / acosf(1 - SEGMENTS_ERROR / r));
+
+		if (segments < SEGMENTS_MIN)
+			segments = SEGMENTS_MIN;
+		if (segments > SEGMENTS_MAX)
+			segments = SEGMENTS_MAX;
+		return (segments + 1) & ~1;
+	}
+
+	void ShapeBatch::addQuad(float x0, float y0, unsigned int c0, float x1, float y1, unsigned int c1, float x2, float y2, unsigned int c2, float x3, float y3, unsigned int c3) {
+		_x.push_back(x0); _y.push_back(y0); _rgba.push_back(c0);
+		_x.push_back(x1); _y.push_back(y1); _rgba.push_back(c1);
+		_x.push_back(x2); _y.push_back(y2); _rgba.push_back(c2);
+		_x.push_back(x3); _y.push_back(y3); _rgba.push_back(c3);
+	}
+
+	//---------------------------------------------------------------------------
+	// Draw Functions
+	//---------------------------------------------------------------------------
+	void ShapeBatch::Flush() {
+		if (_mini && !_x.empty())
+			_mini->DrawColoredQuads(&_x[0], &_y[0], _x.size() / 4, ZIndex, &_rgba[0]);
+
+		Clear();
+	}
+
+	void ShapeBatch::Clear() {
+		// clear() keeps capacity so a steady state frame does not allocate
+		_x.clear();
+		_y.clear();
+		_rgba.clear();
+	}
+
+	//---------------------------------------------------------------------------
+	// Get Functions
+	//---------------------------------------------------------------------------
+	int ShapeBatch::GetQuadCount() {
+		return _x.size() / 4;
+	}
+
+}
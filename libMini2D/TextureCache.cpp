@@ -0,0 +1,145 @@
+/*
+ * TextureCache.cpp
+ *
+ *  Created on: October 19th, 2026
+ *  Author: Daniel Gerendasy
+ */
+
+#include <string.h>                              // memset
+
+#include <Mini2D/Mini.hpp>                       // Mini class
+#include <Mini2D/TextureCache.hpp>               // Class definition
+
+#define FNV_PRIME 0x100000001B3ULL
+
+namespace Mini2D {
+
+	//---------------------------------------------------------------------------
+	// Init Functions
+	//---------------------------------------------------------------------------
+	TextureCache::TextureCache(Mini * mini) : _mini(mini) {
+		memset(&_stats, 0, sizeof(TextureCacheStats));
+	}
+
+	TextureCache::~TextureCache() {
+		// The texture heap goes away with Mini. Entries that Images still hold are detached, not deleted
+		Clear();
+		_mini = NULL;
+	}
+
+	unsigned long long TextureCache::Hash(const void * data, unsigned int size, unsigned long long seed) {
+		const unsigned char * bytes = (const unsigned char *)data;
+		unsigned int i;
+
+		for (i = 0; i < size; i++) {
+			seed ^= bytes[i];
+			seed *= FNV_PRIME;
+		}
+
+		return seed;
+	}
+
+	//---------------------------------------------------------------------------
+	// Entry Functions
+	//---------------------------------------------------------------------------
+	TextureCache::CacheEntry * TextureCache::Acquire(unsigned long long key) {
+		std::map<unsigned long long, CacheEntry*>::iterator it = _entries.find(key);
+
+		if (it == _entries.end()) {
+			_stats.Misses++;
+			return NULL;
+		}
+
+		_stats.Hits++;
+		it->second->RefCount++;
+		return it->second;
+	}
+
+	TextureCache::CacheEntry * TextureCache::Insert(unsigned long long key, const Texture& texture) {
+		std::map<unsigned long long, CacheEntry*>::iterator it = _entries.find(key);
+		CacheEntry * entry = new CacheEntry();
+
+		// Drop an entry with the same key. Free it now if nothing holds it, otherwise on its last release
+		if (it != _entries.end()) {
+			_stats.Entries--;
+			_stats.Bytes -= it->second->Data.Size;
+
+			if (it->second->RefCount <= 0) {
+				if (_mini && it->second->Data.Pointer)
+					_mini->FreeTexture(it->second->Data.Pointer, it->second->Data.Size);
+				delete it->second;
+			}
+			else
+				_replaced.push_back(it->second);
+		}
+
+		entry->Key = key;
+		entry->RefCount = 1;
+		entry->Data = texture;
+		entry->Owner = this;
+		_entries[key] = entry;
+
+		_stats.Entries++;
+		_stats.Bytes += texture.Size;
+
+		return entry;
+	}
+
+	void TextureCache::Release(CacheEntry * entry) {
+		std::map<unsigned long long, CacheEntry*>::iterator it;
+		std::vector<CacheEntry*>::iterator r;
+		TextureCache * owner;
+
+		if (!entry || --entry->RefCount > 0)
+			return;
+
+		// Entries detached by Clear() no longer own heap memory
+		owner = entry->Owner;
+		if (owner) {
+			it = owner->_entries.find(entry->Key);
+			if (it != owner->_entries.end() && it->second == entry) {
+				owner->_entries.erase(it);
+				owner->_stats.Entries--;
+				owner->_stats.Bytes -= entry->Data.Size;
+			}
+			else {
+				for (r = owner->_replaced.begin(); r != owner->_replaced.end(); r++) {
+					if (*r == entry) {
+						owner->_replaced.erase(r);
+						break;
+					}
+				}
+			}
+
+			if (owner->_mini && entry->Data.Pointer)
+				owner->_mini->FreeTexture(entry->Data.Pointer, entry->Data.Size);
+		}
+
+		delete entry;
+	}
+
+	void TextureCache::Clear() {
+		std::map<unsigned long long, CacheEntry*>::iterator it;
+		std::vector<CacheEntry*>::iterator r;
+
+		for (it = _entries.begin(); it != _entries.end(); it++) {
+			if (it->second->RefCount <= 0)
+				delete it->second;
+			else
+				it->second->Owner = NULL;
+		}
+
+		for (r = _replaced.begin(); r != _replaced.end(); r++)
+			(*r)->Owner = NULL;
+
+		_entries.clear();
+		_replaced.clear();
+		_stats.Entries = 0;
+		_stats.Bytes = 0;
+	}
+
+	TextureCache::TextureCacheStats TextureCache::GetStats() {
+		return _stats;
+	}
+
+}
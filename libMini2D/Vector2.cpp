@@ -7,6 +7,13 @@
 
 #include <math.h>                                // pow()
 
+#ifdef __ALTIVEC__
+#include <altivec.h>                             // AltiVec intrinsics
+#undef vector                                    // Keep the C++ keywords usable
+#undef pixel
+#undef bool
+#endif
+
 #include <Mini2D/Units.hpp>                      // class definition
 
 #define PI 3.14159265
@@ -143,4 +150,48 @@ namespace Mini2D {
 		return -RAD2DEG(atan2(in->Y,in->X));
 	}
 
+	//---------------------------------------------------------------------------
+	// Batch Functions
+	//---------------------------------------------------------------------------
+	void Vector2::RotateAroundPoint(float * x, float * y, int count, Vector2 * point, float angle) {
+		int i = 0;
+		float c, s, px, py, dx, dy;
+
+		if (!x || !y || !point || count <= 0)
+			return;
+
+		c = cos(DEG2RAD(-angle));
+		s = sin(DEG2RAD(-angle));
+		px = point->X;
+		py = point->Y;
+
+#ifdef __ALTIVEC__
+		// Process four points at a time when both arrays are aligned
+		if (!(((unsigned long)x | (unsigned long)y) & 15)) {
+			__vector float vc = (__vector float){c,c,c,c};
+			__vector float vs = (__vector float){s,s,s,s};
+			__vector float vpx = (__vector float){px,px,px,px};
+			__vector float vpy = (__vector float){py,py,py,py};
+			__vector float vx, vy;
+
+			for (; (i+4) <= count; i += 4) {
+				vx = vec_sub(vec_ld(0, x+i), vpx);
+				vy = vec_sub(vec_ld(0, y+i), vpy);
+
+				vec_st(vec_madd(vc, vx, vec_madd(vs, vy, vpx)), 0, x+i);
+				vec_st(vec_madd(vc, vy, vec_nmsub(vs, vx, vpy)), 0, y+i);
+			}
+		}
+#endif
+
+		// Scalar fallback and remainder
+		for (; i < count; i++) {
+			dx = x[i]-px;
+			dy = y[i]-py;
+
+			x[i] = (c*dx + s*dy) + px;
+			y[i] = (c*dy - s*dx) + py;
+		}
+	}
+
 }
@@ -92,14 +92,15 @@ int main(s32 argc, const char* argv[]) {
 	PRINT_SLIDER_POWER = Vector2(			CENTER.X,						0.95*mini->MAXH);
 
 
-	// Load background paper
+	// Load background paper (opaque so 16 bits per pixel is plenty)
 	paper = new Image(mini);
-	paper->Load((void*)paper_jpg, paper_jpg_size, Image::IMAGE_TYPE_JPG);
+	paper->Load((void*)paper_jpg, paper_jpg_size, Image::IMAGE_TYPE_JPG, Pixel::PIXEL_FORMAT_R5G6B5);
 	paper->DrawRegion.Location = CENTER;
 	paper->DrawRegion.Dimension = SIZE_PAPER;
 
-	// Load ball
+	// Load ball (drawn far smaller than its source so sample from mipmaps)
 	ball = new Image(mini);
+	ball->Mipmaps = 1;
 	ball->Load((void*)ball_png, ball_png_size, Image::IMAGE_TYPE_PNG);
 	ball->DrawRegion.Dimension = SIZE_BALL;
 
@@ -143,9 +144,9 @@ int drawUpdate(float deltaTime, unsigned long frame) {
     	count++;
  	}
 
- 	// Draw power scale bar
+ 	// Draw power scale bar, fading in from the left
 	float scaleW = BallSpeed/SLIDER_BALLSPEED_MAX;
-	mini->DrawRectangle(PRINT_SLIDER_POWER.X,PRINT_SLIDER_POWER.Y,PRINT_SLIDER_POWER.X,PRINT_SLIDER_POWER.Y,0,scaleW*mini->MAXW,0.1*mini->MAXH,0xC00000FF,0);
+	mini->DrawRectangle(PRINT_SLIDER_POWER.X,PRINT_SLIDER_POWER.Y,PRINT_SLIDER_POWER.X,PRINT_SLIDER_POWER.Y,0,scaleW*mini->MAXW,0.1*mini->MAXH,0x400000FF,0xC00000FF,0xC00000FF,0x400000FF,0);
 
  	// Print FPS
  	openSansRegular->TextAlign = Font::PRINT_ALIGN_CENTERLEFT;
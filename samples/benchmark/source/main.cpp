@@ -0,0 +1,802 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <malloc.h>
+#include <wchar.h>
+#include <math.h>
+#include <io/pad.h>
+#include <sys/time.h>
+
+#include <vector>
+#include <string>
+
+#include <Mini2D/Mini.hpp>
+#include <Mini2D/Font.hpp>
+#include <Mini2D/Collision.hpp>
+#include <Mini2D/DrawQueue.hpp>
+#include <Mini2D/AnimatedImage.hpp>
+#include <Mini2D/Pixel.hpp>
+#include <Mini2D/Image.hpp>
+#include <Mini2D/TextureCache.hpp>
+#include <Mini2D/Layer.hpp>
+#include <Mini2D/ShapeBatch.hpp>
+#include <Mini2D/Emitter.hpp>
+#include <Mini2D/EmitterManager.hpp>
+#include <Mini2D/JobSystem.hpp>
+
+#include "comfortaa_regular_ttf.h"
+#include "ball_png.h"
+
+//
+using namespace Mini2D;
+
+// callbacks
+int drawUpdate(float deltaTime, unsigned long frame);
+void padUpdate(int changed, int port, padData pData);
+void exit();
+
+// benchmarks
+void runBenchmarks();
+void benchCollision(int bodies);
+void benchDrawQueue(int commands);
+void benchAnimation(int instances);
+void benchPixel(Pixel::PixelFormat format, const wchar_t * name);
+void benchTextureCache(int images);
+void benchDecodeKernels();
+void benchNineSlice(int panels);
+void benchShapeBatch(int shapes);
+void benchParticles(int particles, int colliders);
+void benchBallistic(int particles);
+void benchEmitterManager(int emitters);
+void benchFontMeasure(int characters);
+
+// Current time in milliseconds
+double now();
+// Print result to stdout and add it to the on-screen list
+void addResult(const wchar_t * format, ...);
+
+Mini * mini = NULL;
+Font * comfortaa = NULL;
+Layer * resultsLayer = NULL;
+
+int doExit = 0;
+int doRun = 1;
+
+std::vector<std::wstring> results;
+
+// Font sizes
+float FONT_MEDIUM;
+// Font locations
+Vector2 PRINT_TITLE;
+Vector2 PRINT_STATS;
+Vector2 PRINT_RESULTS;
+
+std::wstring TEXT_TITLE = 		L"Press CROSS to run the benchmarks again, SQUARE to toggle the render thread";
+
+int main(s32 argc, const char* argv[]) {
+
+	// Load Mini
+	mini = new Mini((Mini::PadCallback_f)&padUpdate, (Mini::DrawCallback_f)&drawUpdate, (Mini::ExitCallback_f)&exit);
+
+	// Initialize location and size vectors
+	FONT_MEDIUM = 0.015*mini->MAXW;
+
+	PRINT_TITLE = Vector2(0.05*mini->MAXW, 0.05*mini->MAXH);
+	PRINT_STATS = Vector2(0.05*mini->MAXW, 0.085*mini->MAXH);
+	PRINT_RESULTS = Vector2(0.05*mini->MAXW, 0.12*mini->MAXH);
+
+	// Load comfortaa font
+	comfortaa = new Font(mini);
+	comfortaa->Load((void*)comfortaa_regular_ttf, comfortaa_regular_ttf_size, 64);
+	comfortaa->ForeColor = 0xFFFFFFFF;
+
+	// Results only change when the benchmarks run, so they are drawn once into a layer
+	resultsLayer = new Layer(mini, mini->MAXW, mini->MAXH);
+
+	mini->SetPremultipliedAlpha(1);
+	mini->SetAnalogDeadzone(15);
+	mini->SetClearColor(0xFF000000);
+	mini->SetAlphaState(1);
+	mini->BeginDrawLoop();
+
+	return 0;
+}
+
+int drawUpdate(float deltaTime, unsigned long frame) {
+	Vector2 loc = PRINT_RESULTS;
+	Mini::FrameStats stats = mini->GetFrameStats();
+	wchar_t line[256];
+
+	// Run after the first frame has been shown so that the screen is not black while we wait
+	if (doRun && frame > 0) {
+		runBenchmarks();
+		resultsLayer->Invalidate();
+		doRun = 0;
+	}
+
+	if (resultsLayer->Begin()) {
+		for (std::vector<std::wstring>::iterator it = results.begin(); it != results.end(); it++) {
+			comfortaa->PrintLine(*it, NULL, loc, FONT_MEDIUM);
+			loc.Y += FONT_MEDIUM * 1.2f;
+		}
+		resultsLayer->End();
+	}
+
+	comfortaa->PrintLine(doRun ? L"Running..." : TEXT_TITLE, NULL, PRINT_TITLE, FONT_MEDIUM);
+
+	// Live frame timings, to compare immediate and pipelined drawing
+	swprintf(line, 256, L"%ls: record %6.3f ms, submit %6.3f ms, flip %6.3f ms, latency %6.3f ms, frame %6.3f ms",
+		mini->GetPipelined() ? L"Render thread" : L"Immediate",
+		stats.RecordTime, stats.SubmitTime, stats.FlipTime, stats.Latency, stats.FrameTime);
+	comfortaa->PrintLine(line, NULL, PRINT_STATS, FONT_MEDIUM);
+
+	resultsLayer->Draw();
+
+	return doExit;
+}
+
+void padUpdate(int changed, int port, padData pData) {
+	if (pData.BTN_START && changed & Mini::BTN_CHANGED_START)
+		doExit = -1;
+
+	if (pData.BTN_CROSS && changed & Mini::BTN_CHANGED_CROSS)
+		doRun = 1;
+
+	if (pData.BTN_SQUARE && changed & Mini::BTN_CHANGED_SQUARE)
+		mini->SetPipelined(!mini->GetPipelined());
+}
+
+void exit() {
+	printf("exiting\n");
+
+	if (resultsLayer) {
+		delete resultsLayer;
+		resultsLayer = NULL;
+	}
+
+	if (comfortaa) {
+		delete comfortaa;
+		comfortaa = NULL;
+	}
+
+	if (mini) {
+		delete mini;
+		mini = NULL;
+	}
+}
+
+//---------------------------------------------------------------------------
+// Benchmarks
+//---------------------------------------------------------------------------
+void runBenchmarks() {
+	results.clear();
+
+	addResult(L"Collision (brute force vs spatial hash)");
+	benchCollision(100);
+	benchCollision(1000);
+	benchCollision(10000);
+
+	addResult(L"DrawQueue (record and radix sort by layer, blend, texture)");
+	benchDrawQueue(100);
+	benchDrawQueue(1000);
+	benchDrawQueue(10000);
+
+	addResult(L"AnimatedImage (batched SpriteSheet::Update)");
+	benchAnimation(1000);
+	benchAnimation(10000);
+
+	addResult(L"Pixel (convert 512x512 ARGB)");
+	benchPixel(Pixel::PIXEL_FORMAT_R5G6B5, L"R5G6B5");
+	benchPixel(Pixel::PIXEL_FORMAT_A4R4G4B4, L"A4R4G4B4");
+	benchPixel(Pixel::PIXEL_FORMAT_A1R5G5B5, L"A1R5G5B5");
+	benchPixel(Pixel::PIXEL_FORMAT_L8, L"L8");
+	benchPixel(Pixel::PIXEL_FORMAT_DXT1, L"DXT1");
+	benchPixel(Pixel::PIXEL_FORMAT_DXT5, L"DXT5");
+
+	addResult(L"Pixel (decoder kernels on 512x512)");
+	benchDecodeKernels();
+
+	addResult(L"TextureCache (load one PNG into many Images)");
+	benchTextureCache(10);
+	benchTextureCache(100);
+
+	addResult(L"Image (nine slice panels as 9 DrawPart vs DrawNineSlice)");
+	benchNineSlice(100);
+	benchNineSlice(1000);
+
+	addResult(L"ShapeBatch (rectangles as DrawRectangle vs one batch)");
+	benchShapeBatch(100);
+	benchShapeBatch(1000);
+
+	addResult(L"Emitter (particle update jobs inline vs JobSystem workers)");
+	benchParticles(10000, 0);
+	benchParticles(100000, 0);
+	benchParticles(10000, 8);
+
+	addResult(L"Emitter (gravity only particles integrated vs ballistic)");
+	benchBallistic(10000);
+	benchBallistic(100000);
+
+	addResult(L"EmitterManager (streaming emitters under a 10000 particle budget)");
+	benchEmitterManager(8);
+	benchEmitterManager(32);
+
+	addResult(L"Font (measuring text per character vs one MeasureLine)");
+	benchFontMeasure(100);
+	benchFontMeasure(1000);
+}
+
+void benchCollision(int bodies) {
+	int i, j, iterations, brutePairs = 0, hashPairs = 0;
+	double t, bruteMs, hashMs;
+	float world, r;
+	std::vector<CircleF> circles(bodies);
+	Collision collision(32, bodies);
+
+	// Keep the density the same for every body count
+	world = 40.f * sqrt((float)bodies);
+
+	srand(bodies);
+	for (i = 0; i < bodies; i++) {
+		r = 2 + (rand() % 12);
+		circles[i].Location.Set(rand() % (int)world, rand() % (int)world);
+		circles[i].Radius = r;
+		collision.Add(&circles[i]);
+	}
+
+	// Brute force is quadratic so fewer iterations are averaged for large counts
+	iterations = bodies >= 10000 ? 1 : (bodies >= 1000 ? 5 : 100);
+
+	t = now();
+	for (int k = 0; k < iterations; k++) {
+		brutePairs = 0;
+		for (i = 0; i < bodies; i++)
+			for (j = i+1; j < bodies; j++)
+				if (Collision::Intersect(&circles[i], &circles[j], NULL))
+					brutePairs++;
+	}
+	bruteMs = (now() - t) / iterations;
+
+	iterations = bodies >= 10000 ? 10 : 100;
+
+	t = now();
+	for (int k = 0; k < iterations; k++)
+		hashPairs = collision.Update();
+	hashMs = (now() - t) / iterations;
+
+	addResult(L"  %5d bodies: brute %8.3f ms (%d pairs), hash %8.3f ms (%d pairs), %.1fx",
+		bodies, bruteMs, brutePairs, hashMs, hashPairs, hashMs > 0 ? bruteMs / hashMs : 0);
+}
+
+void benchDrawQueue(int commands) {
+	int i, k, iterations = 100;
+	double t, ms;
+	DrawQueue queue(commands);
+	DrawQueue::DrawCommand command;
+
+	memset(&command, 0, sizeof(DrawQueue::DrawCommand));
+	command.Type = DrawQueue::DRAW_COMMAND_TEXTURE;
+	command.View = -1;
+
+	// The first frame sizes the queue, after that nothing should allocate
+	t = 0;
+	for (k = 0; k <= iterations; k++) {
+		double start = now();
+
+		srand(commands);
+		queue.Clear();
+		for (i = 0; i < commands; i++) {
+			command.Z = rand() % 16;
+			command.TextureOff = (rand() % 8) * 0x10000;
+			queue.Push(command);
+		}
+		queue.Sort();
+
+		if (k > 0)
+			t += now() - start;
+	}
+	ms = t / iterations;
+
+	addResult(L"  %5d commands: %8.3f ms/frame", commands, ms);
+}
+
+void benchAnimation(int instances) {
+	int i, iterations = 100;
+	double t, ms;
+	SpriteSheet sheet(NULL);
+	std::vector<AnimatedImage*> images(instances);
+
+	sheet.AddFrames(0, 0, 32, 32, 8, 16, 1/30.f);
+	for (i = 0; i < instances; i++) {
+		images[i] = new AnimatedImage(&sheet);
+		images[i]->Mode = (AnimatedImage::AnimationMode)(i % 3);
+		images[i]->Speed = 0.5f + (i % 4) * 0.5f;
+	}
+
+	t = now();
+	for (i = 0; i < iterations; i++)
+		sheet.Update(1/60.f);
+	ms = (now() - t) / iterations;
+
+	for (i = 0; i < instances; i++)
+		delete images[i];
+
+	addResult(L"  %5d instances: %8.3f ms/frame", instances, ms);
+}
+
+void benchPixel(Pixel::PixelFormat format, const wchar_t * name) {
+	int i, size = 512, iterations = 10;
+	double t, ms;
+	unsigned int * argb = (unsigned int*)memalign(16, size * size * 4);
+	void * out = memalign(16, Pixel::GetPitch(format, size) * Pixel::GetRows(format, size));
+
+	srand(size);
+	for (i = 0; i < size * size; i++)
+		argb[i] = (rand() << 16) ^ rand();
+
+	t = now();
+	for (i = 0; i < iterations; i++)
+		Pixel::Convert(argb, size, size, size * 4, format, out);
+	ms = (now() - t) / iterations;
+
+	free(argb);
+	free(out);
+
+	addResult(L"  %-8ls: %8.3f ms (%.1f MB/s)", name, ms, ms > 0 ? (size * size * 4) / (ms * 1000.0) : 0);
+}
+
+void benchDecodeKernels() {
+	int i, y, size = 512, iterations = 10;
+	double t[3];
+	unsigned char * bytes = (unsigned char*)memalign(16, size * size * 4);
+	unsigned int * argb = (unsigned int*)memalign(16, size * size * 4);
+
+	srand(size);
+	for (i = 0; i < size * size * 4; i++)
+		bytes[i] = rand();
+
+	t[0] = now();
+	for (i = 0; i < iterations; i++)
+		for (y = 0; y < size; y++)
+			Pixel::FromRGBA(bytes + y * size * 4, argb + y * size, size);
+	t[1] = now();
+	for (i = 0; i < iterations; i++)
+		for (y = 0; y < size; y++)
+			Pixel::FromRGB(bytes + y * size * 3, argb + y * size, size);
+	t[2] = now();
+	for (i = 0; i < iterations; i++)
+		Pixel::Premultiply(argb, size, size, size * 4);
+
+	addResult(L"  FromRGBA   : %8.3f ms", (t[1] - t[0]) / iterations);
+	addResult(L"  FromRGB    : %8.3f ms", (t[2] - t[1]) / iterations);
+	addResult(L"  Premultiply: %8.3f ms", (now() - t[2]) / iterations);
+
+	free(bytes);
+	free(argb);
+}
+
+void benchTextureCache(int images) {
+	int i;
+	double t, miss, hit;
+	std::vector<Image*> loaded(images);
+	TextureCache::TextureCacheStats before = mini->GetTextureCache()->GetStats(), after;
+
+	// The first load decodes and uploads, every other load shares its texture
+	t = now();
+	loaded[0] = new Image(mini);
+	loaded[0]->Load((void*)ball_png, ball_png_size, Image::IMAGE_TYPE_PNG);
+	miss = now() - t;
+
+	t = now();
+	for (i = 1; i < images; i++) {
+		loaded[i] = new Image(mini);
+		loaded[i]->Load((void*)ball_png, ball_png_size, Image::IMAGE_TYPE_PNG);
+	}
+	hit = images > 1 ? (now() - t) / (images - 1) : 0;
+
+	after = mini->GetTextureCache()->GetStats();
+	for (i = 0; i < images; i++)
+		delete loaded[i];
+
+	addResult(L"  %5d images: miss %8.3f ms, hit %8.3f ms (%u hits, %u misses)", images, miss, hit, after.Hits - before.Hits, after.Misses - before.Misses);
+}
+
+void benchNineSlice(int panels) {
+	int i, j, k, iterations = 10;
+	unsigned int partCommands, sliceCommands;
+	double t, partMs, sliceMs;
+	float b = 8, w, h, cx[3], cy[3], dw[3], dh[3], sx[3], sy[3], sw[3], sh[3];
+	DrawQueue queue(panels * 9);
+	Image image(mini);
+	RectangleF region(0, 0, 200, 100), part;
+
+	image.Load((void*)ball_png, ball_png_size, Image::IMAGE_TYPE_PNG);
+	w = image.GetWidth();
+	h = image.GetHeight();
+
+	// Center and size of each column and row relative to the panel, and the part of the image it shows
+	cx[0] = b / 2 - 100; dw[0] = b;           sx[0] = 0;     sw[0] = b;
+	cx[1] = 0;           dw[1] = 200 - 2 * b; sx[1] = b;     sw[1] = w - 2 * b;
+	cx[2] = 100 - b / 2; dw[2] = b;           sx[2] = w - b; sw[2] = b;
+	cy[0] = b / 2 - 50;  dh[0] = b;           sy[0] = 0;     sh[0] = b;
+	cy[1] = 0;           dh[1] = 100 - 2 * b; sy[1] = b;     sh[1] = h - 2 * b;
+	cy[2] = 50 - b / 2;  dh[2] = b;           sy[2] = h - b; sh[2] = b;
+
+	mini->SetDrawQueue(&queue);
+
+	t = now();
+	for (k = 0; k < iterations; k++) {
+		queue.Clear();
+		for (i = 0; i < panels; i++) {
+			for (j = 0; j < 9; j++) {
+				part.X((i % 20) * 40 + cx[j % 3]);
+				part.Y((i / 20) * 10 + cy[j / 3]);
+				part.W(dw[j % 3]);
+				part.H(dh[j / 3]);
+				image.DrawPart(&part, 0, sx[j % 3], sy[j / 3], sw[j % 3], sh[j / 3]);
+			}
+		}
+	}
+	partMs = (now() - t) / iterations;
+	partCommands = queue.Count();
+
+	t = now();
+	for (k = 0; k < iterations; k++) {
+		queue.Clear();
+		for (i = 0; i < panels; i++) {
+			region.X((i % 20) * 40);
+			region.Y((i / 20) * 10);
+			image.DrawNineSlice(&region, 0, b, b, b, b);
+		}
+	}
+	sliceMs = (now() - t) / iterations;
+	sliceCommands = queue.Count();
+
+	queue.Clear();
+	mini->SetDrawQueue(NULL);
+
+	addResult(L"  %5d panels: DrawPart %8.3f ms (%u cmds), DrawNineSlice %8.3f ms (%u cmds)", panels, partMs, partCommands, sliceMs, sliceCommands);
+}
+
+void benchShapeBatch(int shapes) {
+	int i, k, iterations = 10;
+	unsigned int rectCommands, batchCommands;
+	double t, rectMs, batchMs;
+	DrawQueue queue(shapes);
+	ShapeBatch batch(mini, shapes);
+	RectangleF rect(0, 0, 30, 6);
+
+	mini->SetDrawQueue(&queue);
+
+	t = now();
+	for (k = 0; k < iterations; k++) {
+		queue.Clear();
+		for (i = 0; i < shapes; i++)
+			mini->DrawRectangle((i % 20) * 40, (i / 20) * 10, (i % 20) * 40, (i / 20) * 10, 0, 30, 6, 0x400000FF, 0xC00000FF, 0xC00000FF, 0x400000FF, 0);
+	}
+	rectMs = (now() - t) / iterations;
+	rectCommands = queue.Count();
+
+	t = now();
+	for (k = 0; k < iterations; k++) {
+		queue.Clear();
+		for (i = 0; i < shapes; i++) {
+			rect.X((i % 20) * 40);
+			rect.Y((i / 20) * 10);
+			batch.AddRectangle(&rect, 0x400000FF, 0xC00000FF, 0xC00000FF, 0x400000FF);
+		}
+		batch.Flush();
+	}
+	batchMs = (now() - t) / iterations;
+	batchCommands = queue.Count();
+
+	queue.Clear();
+	mini->SetDrawQueue(NULL);
+
+	addResult(L"  %5d rects: DrawRectangle %8.3f ms (%u cmds), ShapeBatch %8.3f ms (%u cmds)", shapes, rectMs, rectCommands, batchMs, batchCommands);
+}
+
+void benchParticles(int particles, int colliders) {
+	int i, k, workers, iterations = 10, chunks = (particles + PARTICLE_CHUNK - 1) / PARTICLE_CHUNK;
+	int counts[] = { 0, 1, 2, 4, 8 };
+	double t, ms, inlineMs = 0;
+	bool match;
+	std::vector<float> state(particles * 9), start(particles * 9), life(particles, 6), corners(particles * 8), reference;
+	std::vector<unsigned int> rgba(particles, 0xFFFFFFFF), colors(particles);
+	std::vector<int> dead(particles);
+	std::vector<Emitter::ParticleJob> jobs(chunks);
+	Emitter::EmitterAttractor attractor = { 424, 256, 200, 300 };
+	float curve[EMITTER_CURVE_SIZE];
+	std::vector<Emitter::ParticleCollider> shapes(colliders > 0 ? colliders : 1);
+	JobSystem * system;
+
+	// Fade and shrink over life, pulled down and toward the center
+	for (i = 0; i < EMITTER_CURVE_SIZE; i++)
+		curve[i] = 1 - (float)i / EMITTER_CURVE_SIZE;
+
+	// Circles in a row across the screen
+	for (i = 0; i < colliders; i++) {
+		Emitter::ParticleCollider& shape = shapes[i];
+		shape.X = (i + 0.5f) * 848 / colliders;
+		shape.Y = 384;
+		shape.Radius = 848 / colliders / 3;
+		shape.MinX = shape.X - shape.Radius;
+		shape.MaxX = shape.X + shape.Radius;
+		shape.MinY = shape.Y - shape.Radius;
+		shape.MaxY = shape.Y + shape.Radius;
+		shape.AxisX = 1;
+		shape.AxisY = 0;
+		shape.HalfW = shape.HalfH = shape.Radius;
+	}
+
+	// Fields are stored one after another (X, Y, VelocityX, VelocityY, Angle, AngleVelocity, TTL, W, H)
+	for (i = 0; i < particles; i++) {
+		start[particles * 0 + i] = i % 848;
+		start[particles * 1 + i] = (i * 7) % 512;
+		start[particles * 2 + i] = (i % 13) * 10 - 60;
+		start[particles * 3 + i] = (i % 11) * 10 - 50;
+		start[particles * 4 + i] = i % 360;
+		start[particles * 5 + i] = (i % 7) * 30;
+		start[particles * 6 + i] = 1 + (i % 5);
+		start[particles * 7 + i] = 4 + (i % 8);
+		start[particles * 8 + i] = 4 + (i % 6);
+	}
+
+	for (k = 0; k < chunks; k++) {
+		Emitter::ParticleJob& job = jobs[k];
+		i = k * PARTICLE_CHUNK;
+
+		job.X = &state[particles * 0 + i];
+		job.Y = &state[particles * 1 + i];
+		job.VelocityX = &state[particles * 2 + i];
+		job.VelocityY = &state[particles * 3 + i];
+		job.Angle = &state[particles * 4 + i];
+		job.AngleVelocity = &state[particles * 5 + i];
+		job.TTL = &state[particles * 6 + i];
+		job.Life = &life[i];
+		job.W = &state[particles * 7 + i];
+		job.H = &state[particles * 8 + i];
+		job.RGBA = &rgba[i];
+		job.Birth = NULL;
+		job.Count = particles - i < PARTICLE_CHUNK ? particles - i : PARTICLE_CHUNK;
+		job.DeltaTime = 1 / 60.0;
+		job.Time = 0;
+		job.ClipMinX = 0;
+		job.ClipMinY = 0;
+		job.ClipMaxX = 848;
+		job.ClipMaxY = 512;
+		job.GravityX = 0;
+		job.GravityY = 98;
+		job.DragFactor = expf(-0.5f / 60);
+		job.Attractors = &attractor;
+		job.AttractorCount = 1;
+		job.ColorCurve = NULL;
+		job.AlphaCurve = curve;
+		job.SizeCurve = curve;
+		job.Colliders = &shapes[0];
+		job.ColliderCount = colliders;
+		job.Restitution = 0.5f;
+		job.CornersX = &corners[i * 4];
+		job.CornersY = &corners[particles * 4 + i * 4];
+		job.Colors = &colors[i];
+		job.Dead = &dead[i];
+	}
+
+	// Every run starts from the same state, so each system must produce the inline result
+	for (k = 0; k < (int)(sizeof(counts) / sizeof(counts[0])); k++) {
+		workers = counts[k];
+		system = workers ? new JobSystem(workers) : NULL;
+		state = start;
+
+		t = now();
+		for (i = 0; i < iterations; i++) {
+			if (system)
+				system->ParallelFor(Emitter::UpdateJobs, &jobs[0], chunks, 1);
+			else
+				Emitter::UpdateJobs(&jobs[0], 0, chunks);
+		}
+		ms = (now() - t) / iterations;
+
+		if (!system) {
+			inlineMs = ms;
+			reference = corners;
+			match = 1;
+		}
+		else
+			match = corners == reference;
+
+		if (system)
+			delete system;
+
+		addResult(L"  %6d particles, %d colliders, %d workers: %8.3f ms (%.1fx)%ls", particles, colliders, workers, ms, ms > 0 ? inlineMs / ms : 0, match ? L"" : L" MISMATCH");
+	}
+}
+
+void benchBallistic(int particles) {
+	int i, k, v, frames = 60, chunks = (particles + PARTICLE_CHUNK - 1) / PARTICLE_CHUNK;
+	double t, integratedMs, ballisticMs;
+	float x, y, age, error = 0;
+	std::vector<float> state(particles * 9), start(particles * 9), life(particles, 10), birth(particles), corners(particles * 8);
+	std::vector<unsigned int> rgba(particles, 0xFFFFFFFF), colors(particles);
+	std::vector<int> dead(particles);
+	std::vector<Emitter::ParticleJob> jobs(chunks);
+
+	// Fields are stored one after another (X, Y, VelocityX, VelocityY, Angle, AngleVelocity, TTL, W, H)
+	for (i = 0; i < particles; i++) {
+		start[particles * 0 + i] = i % 848;
+		start[particles * 1 + i] = (i * 7) % 512;
+		start[particles * 2 + i] = (i % 13) * 10 - 60;
+		start[particles * 3 + i] = (i % 11) * 10 - 50;
+		start[particles * 4 + i] = 0;
+		start[particles * 5 + i] = (i % 7) * 30;
+		start[particles * 6 + i] = 10;
+		start[particles * 7 + i] = 4 + (i % 8);
+		start[particles * 8 + i] = 4 + (i % 6);
+		birth[i] = -(i % 10) / 10.f;
+	}
+
+	for (k = 0; k < chunks; k++) {
+		Emitter::ParticleJob& job = jobs[k];
+		i = k * PARTICLE_CHUNK;
+
+		memset(&job, 0, sizeof(job));
+		job.X = &state[particles * 0 + i];
+		job.Y = &state[particles * 1 + i];
+		job.VelocityX = &state[particles * 2 + i];
+		job.VelocityY = &state[particles * 3 + i];
+		job.Angle = &state[particles * 4 + i];
+		job.AngleVelocity = &state[particles * 5 + i];
+		job.TTL = &state[particles * 6 + i];
+		job.Life = &life[i];
+		job.W = &state[particles * 7 + i];
+		job.H = &state[particles * 8 + i];
+		job.RGBA = &rgba[i];
+		job.Count = particles - i < PARTICLE_CHUNK ? particles - i : PARTICLE_CHUNK;
+		job.DeltaTime = 1 / 60.0;
+		job.ClipMinX = -1e9;                     // Everything is drawn, so vertices line up with particles
+		job.ClipMinY = -1e9;
+		job.ClipMaxX = 1e9;
+		job.ClipMaxY = 1e9;
+		job.GravityY = 98;
+		job.DragFactor = 1;
+		job.CornersX = &corners[i * 4];
+		job.CornersY = &corners[particles * 4 + i * 4];
+		job.Colors = &colors[i];
+		job.Dead = &dead[i];
+	}
+
+	// Integrated: every frame reads and writes the whole state
+	state = start;
+	t = now();
+	for (i = 0; i < frames; i++)
+		Emitter::UpdateJobs(&jobs[0], 0, chunks);
+	integratedMs = (now() - t) / frames;
+
+	// Ballistic: the state is only read, positions come from the time
+	state = start;
+	for (k = 0; k < chunks; k++)
+		jobs[k].Birth = &birth[k * PARTICLE_CHUNK];
+	t = now();
+	for (i = 1; i <= frames; i++) {
+		for (k = 0; k < chunks; k++)
+			jobs[k].Time = i / 60.f;
+		Emitter::UpdateJobs(&jobs[0], 0, chunks);
+	}
+	ballisticMs = (now() - t) / frames;
+
+	// Check the last frame against the exact position of each particle
+	for (k = 0; k < chunks; k++) {
+		Emitter::ParticleJob& job = jobs[k];
+		for (v = 0; v < job.Visible; v++) {
+			age = job.Time - job.Birth[v];
+			x = job.X[v] + job.VelocityX[v] * age;
+			y = job.Y[v] + job.VelocityY[v] * age + job.GravityY * age * age / 2;
+			x -= (job.CornersX[v*4+0] + job.CornersX[v*4+1] + job.CornersX[v*4+2] + job.CornersX[v*4+3]) / 4;
+			y -= (job.CornersY[v*4+0] + job.CornersY[v*4+1] + job.CornersY[v*4+2] + job.CornersY[v*4+3]) / 4;
+			if (fabs(x) > error)
+				error = fabs(x);
+			if (fabs(y) > error)
+				error = fabs(y);
+		}
+	}
+
+	addResult(L"  %6d particles: integrated %8.3f ms, ballistic %8.3f ms (%.1fx), max error %.4f px", particles, integratedMs, ballisticMs, ballisticMs > 0 ? integratedMs / ballisticMs : 0, error);
+}
+
+void benchEmitterManager(int emitters) {
+	int i, k, frames = 120;
+	float slowest = 0;
+	double t, ms;
+	DrawQueue queue(emitters);
+	EmitterManager manager(mini, 10000);
+	EmitterManager::EmitterCost cost;
+	Emitter * emitter;
+
+	// Together they ask for far more than the budget
+	for (i = 0; i < emitters; i++) {
+		emitter = manager.Add(4000);
+		emitter->EmissionRate = 1500;
+		emitter->RangeTTL = Vector2(1, 2);
+		emitter->RangeVelocity = Vector2(20, 100);
+		emitter->RangeDimensionW = Vector2(2, 8);
+		emitter->RangeDimensionH = Vector2(2, 8);
+		emitter->Start(Vector2((i % 8) * 100 + 74, (i / 8) * 100 + 56), -1);
+	}
+
+	mini->SetDrawQueue(&queue);
+
+	t = now();
+	for (k = 0; k < frames; k++) {
+		queue.Clear();
+		manager.Draw(1 / 60.0f);
+	}
+	ms = (now() - t) / frames;
+
+	queue.Clear();
+	mini->SetDrawQueue(NULL);
+
+	for (i = 0; i < emitters; i++) {
+		cost = manager.GetCost(i);
+		if (cost.Time > slowest)
+			slowest = cost.Time;
+	}
+
+	addResult(L"  %3d emitters: %8.3f ms/frame, %5d live (budget %u), slowest emitter %.3f ms", emitters, ms, manager.GetLiveCount(), manager.Budget, slowest);
+}
+
+void benchFontMeasure(int characters) {
+	int i, k, iterations = 100;
+	float charWidth = 0, lineWidth = 0;
+	double t, charMs, lineMs, wrapMs;
+	std::wstring text;
+	std::vector<Font::FontLine> lines;
+
+	for (i = 0; i < characters; i++)
+		text += (wchar_t)(i % 10 == 9 ? L' ' : L'a' + (i * 7) % 26);
+
+	// One lookup per character, the way lines were measured before
+	t = now();
+	for (k = 0; k < iterations; k++) {
+		charWidth = 0;
+		for (i = 0; i < characters; i++)
+			charWidth += comfortaa->GetWidth(text[i], FONT_MEDIUM) + (i ? comfortaa->GetKerning(text[i-1], text[i], FONT_MEDIUM) : 0);
+	}
+	charMs = (now() - t) / iterations;
+
+	t = now();
+	for (k = 0; k < iterations; k++)
+		lineWidth = comfortaa->MeasureLine(text, FONT_MEDIUM).Width;
+	lineMs = (now() - t) / iterations;
+
+	// Wrapped to the screen
+	t = now();
+	for (k = 0; k < iterations; k++) {
+		lines.clear();
+		comfortaa->MeasureLines(text, FONT_MEDIUM, mini->MAXW, &lines);
+	}
+	wrapMs = (now() - t) / iterations;
+
+	addResult(L"  %5d chars: per character %8.4f ms, MeasureLine %8.4f ms, wrapped into %d lines %8.4f ms%ls", characters, charMs, lineMs, (int)lines.size(), wrapMs, fabs(charWidth - lineWidth) < 0.01f * characters ? L"" : L" MISMATCH");
+}
+
+//---------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------
+double now() {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+void addResult(const wchar_t * format, ...) {
+	wchar_t buffer[256];
+	va_list args;
+
+	va_start(args, format);
+	vswprintf(buffer, 256, format, args);
+	va_end(args);
+
+	wprintf(L"%ls\n", buffer);
+	results.push_back(buffer);
+}
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 #include <io/pad.h>
 #include <math.h>
 
@@ -6,6 +7,7 @@
 #include <Mini2D/Image.hpp>
 #include <Mini2D/Font.hpp>
 #include <Mini2D/Emitter.hpp>
+#include <Mini2D/EmitterPreset.hpp>
 
 #include "comfortaa_regular_ttf.h"
 
@@ -20,6 +22,7 @@ void exit();
 Mini * mini = NULL;
 
 Emitter * emitter1 = NULL;
+EmitterPreset emitterPreset;
 Font * comfortaa = NULL;
 Image * emitterBackground = NULL;
 
@@ -35,10 +38,31 @@ float FONT_LARGE;
 Vector2 PRINT_ITEM;
 Vector2 PRINT_INC;
 
+// Edit this file while the sample runs to change the emitter
+const char * PRESET_PATH =		"/dev_hdd0/tmp/particletest.m2p";
+
+// Used when PRESET_PATH doesn't exist. Save writes it out as a starting point
+const char * PRESET_TEXT =
+	"MaxParticles 1000\n"
+	"MinParticles 750         # Spawn between this and max\n"
+	"RangeDimensionW 1 4      # Width (default is 10-50)\n"
+	"RangeDimensionH 1 4      # Height (default is 10-50)\n"
+	"RangeVelocity -100 100   # Speed per second (default is 0 to 10)\n"
+	"RangeVelocityTheta 0 360 # Direction (default is 0-360)\n"
+	"RangeRotation -60 60     # Spin per second\n"
+	"RangeTTL 5 10            # Time to live (seconds)\n"
+	"RangeColorRed 255 255    # Color channels (default is 0-255)\n"
+	"RangeColorGreen 255 255\n"
+	"RangeColorBlue 255 255\n"
+	"Revive 1                 # Revive particles that die part way through emission session\n"
+	"SkipExplosion 1          # Skip sequence from start point to outer reaches (smooths loop)\n"
+	"AlphaCurve 1 1 0         # Fade particles out over the last half of their life\n";
+
 std::wstring TEXT_START = 		L"Press CROSS to start the emission";
 std::wstring TEXT_PAUSERESUME = L"Press TRIANGLE to pause/resume the emission";
 std::wstring TEXT_STOP =		L"Press CIRCLE to stop the emission";
 std::wstring TEXT_DIRECT =		L"Use the analog stick to direct the emission";
+std::wstring TEXT_RATE =		L"Press SQUARE to switch between a burst and a steady stream";
 
 int main(s32 argc, const char* argv[]) {
 
@@ -53,21 +77,15 @@ int main(s32 argc, const char* argv[]) {
 	PRINT_ITEM = Vector2(CENTER.X,0.07*mini->MAXH);
 	PRINT_INC = Vector2(0,0.04*mini->MAXH);
 
+	// Load emitter preset. On first run write out the built-in one, then load it back so Reload watches the file
+	if (emitterPreset.Load(PRESET_PATH) != EmitterPreset::PRESET_SUCCESS) {
+		emitterPreset.Load(PRESET_TEXT, strlen(PRESET_TEXT));
+		if (emitterPreset.Save(PRESET_PATH, 0))
+			emitterPreset.Load(PRESET_PATH);
+	}
+
 	// Load emitter
-	emitter1 = new Emitter(mini, 1000);											// Initialize new emitter with 1000 max particles
-	emitter1->RangeDimensionW = 	Vector2(1,4);								// Range for width (default is 10-50)
-	emitter1->RangeDimensionH = 	Vector2(1,4);								// Range for height (default is 10-50)
-	emitter1->RangeVelocity = 		Vector2(-1,1) * 100;						// Range for X velocity per second (default is 0 to 10)
-	emitter1->RangeVelocity = 		Vector2(-1,1) * 100;						// Range for Y velocity per second (default is 0 to 10)
-	emitter1->RangeVelocityTheta =	Vector2(0,360);								// Range for particle velocity direction (default is 0-360)
-	emitter1->RangeRotation =		Vector2(-60,60);							// Range for particle angle rotation per second
-	emitter1->RangeTTL =			Vector2(5,10);								// Range for time to live (seconds)
-	emitter1->RangeColorRed =		Vector2(0xFF, 0xFF);						// Range for color channel red (default is 0-255)
-	emitter1->RangeColorGreen =		Vector2(0xFF, 0xFF);						// Range for color channel green (default is 0-255)
-	emitter1->RangeColorBlue =		Vector2(0xFF, 0xFF);						// Range for color channel blue (deafult is 0-255)
-	emitter1->MinParticles =		750;										// Minimum number of particles to spawn (will spawn between this and max)
-	emitter1->Revive =				1;											// Revive particles that die part way through emission session
-	emitter1->SkipExplosion =		1;											// Skip sequence from start point to outer reaches (smooths loop)
+	emitter1 = emitterPreset.Create(mini);										// Initialize new emitter with the preset's settings
 	emitter1->Clip =				RectangleF(CENTER, CENTER);					// Particles outside this box will not be drawn. Default is (x:0, y:0, w:MAXW, h:MAXH)
 
 	// Load background image
@@ -89,15 +107,24 @@ int main(s32 argc, const char* argv[]) {
 }
 
 int drawUpdate(float deltaTime, unsigned long frame) {
+	// Pick up edits to the preset file about once a second
+	if ((frame % 60) == 0 && emitterPreset.Reload())
+		emitterPreset.Apply(emitter1);
+
 	comfortaa->PrintLine(TEXT_START, NULL, PRINT_ITEM, FONT_LARGE);
 	comfortaa->PrintLine(TEXT_PAUSERESUME, NULL, PRINT_ITEM + PRINT_INC, FONT_LARGE);
 	comfortaa->PrintLine(TEXT_STOP, NULL, PRINT_ITEM + (PRINT_INC*2.f), FONT_LARGE);
 	comfortaa->PrintLine(TEXT_DIRECT, NULL, PRINT_ITEM + (PRINT_INC * 3.f), FONT_LARGE);
+	comfortaa->PrintLine(TEXT_RATE, NULL, PRINT_ITEM + (PRINT_INC * 4.f), FONT_LARGE);
 
 	emitterBackground->Draw(0xFFFFFFFF);
 	if (emitter1->Status())
 		emitter1->Draw(deltaTime);
 
+	// Print draw counts of the last frame
+	Mini::DrawStats stats = mini->GetDrawStats();
+	comfortaa->PrintFormat(PRINT_ITEM + (PRINT_INC * 5.f), FONT_LARGE, 0, 0, 40, L"Drawn: %u  Culled: %u  Particles: %d/%d", stats.Submitted, stats.Culled, emitter1->GetLiveCount(), emitter1->GetMaxParticles());
+
 	return doExit;
 }
 
@@ -114,6 +141,11 @@ void padUpdate(int changed, int port, padData pData) {
 	if (pData.BTN_CIRCLE && changed & Mini::BTN_CHANGED_CIRCLE) {
 		emitter1->Stop();
 	}
+	if (pData.BTN_SQUARE && changed & Mini::BTN_CHANGED_SQUARE) {
+		// 100 per second with lives of 5-10 seconds stays within the 1000 particle pool
+		emitter1->EmissionRate = emitter1->EmissionRate > 0 ? 0 : 100;
+		emitter1->Start(CENTER, -1);
+	}
 	if (pData.BTN_TRIANGLE && changed & Mini::BTN_CHANGED_TRIANGLE) {
 		if (emitter1->Status() == Emitter::EMITTER_PAUSED)
 			emitter1->Resume();